@@ -0,0 +1,18 @@
+#ifndef BENCH_UTILS_H_
+#define BENCH_UTILS_H_
+
+#include <time.h>
+
+/**
+ * @brief Returns monotonic time in seconds
+ *
+ * @return double
+ */
+static double bench_now() {
+    timespec time = {};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+#endif //< #ifndef BENCH_UTILS_H_
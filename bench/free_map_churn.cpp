@@ -0,0 +1,103 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+#include "../src/list_free_map.h"
+
+#include <vector>
+#include <random>
+
+#include "bench_utils.h"
+
+ListLogFileData list_log_file = {"log"};
+
+static const int ROUNDS_NUM = 10;
+static const int WALKS_NUM  = 5;
+
+/**
+ * @brief Returns physical index of random list element
+ *
+ * @param list
+ * @param rng
+ * @return list_idx_t
+ */
+static list_idx_t random_elem_(const List<long>* list, std::mt19937_64* rng) {
+    while (true) {
+        const list_idx_t phys_i = 1 + (list_idx_t)((*rng)() % (uint64_t)(list->free_watermark - 1));
+
+        if (!list_is_free(list, phys_i))
+            return phys_i;
+    }
+}
+
+/**
+ * @brief Pushes back elems_num elements, then runs ROUNDS_NUM rounds of deleting 10% random
+ *        elements and inserting 10% after random elements. Prints insert time, link locality
+ *        and the best time of full walk
+ *
+ * @param elems_num
+ * @param use_free_map list_free_map_enable is called
+ */
+static void bench_free_map_churn(const list_idx_t elems_num, const bool use_free_map) {
+    List<long> list = {};
+    list_ctor(&list, 2);
+
+    if (use_free_map)
+        list_free_map_enable(&list);
+
+    list_idx_t index = 0;
+    for (list_idx_t i = 0; i < elems_num; i++)
+        list_pushback(&list, (long)i, &index);
+
+    std::mt19937_64 rng(5);
+    std::vector<list_idx_t> positions((size_t)(elems_num / 10));
+
+    double insert_time = 0;
+
+    for (int round = 0; round < ROUNDS_NUM; round++) {
+        for (size_t i = 0; i < positions.size(); i++)
+            list_delete(&list, random_elem_(&list, &rng), true);
+
+        for (size_t i = 0; i < positions.size(); i++)
+            positions[i] = random_elem_(&list, &rng);
+
+        const double start = bench_now();
+
+        for (size_t i = 0; i < positions.size(); i++)
+            list_insert_after(&list, positions[i], (long)i, &index);
+
+        insert_time += bench_now() - start;
+    }
+
+    double locality = 0;
+    list_link_locality(&list, &locality);
+
+    double walk_time = 1e9;
+    long long sum = 0;
+
+    for (int walk = 0; walk < WALKS_NUM; walk++) {
+        const double start = bench_now();
+
+        for (list_idx_t phys_i = list_head(&list); phys_i != 0; phys_i = list_next(&list, phys_i))
+            sum += list_elem(&list, phys_i);
+
+        walk_time = MIN(walk_time, bench_now() - start);
+    }
+
+    printf("n %8" LIST_IDX_PRI ", map %-3s: insert %6.1f ns, link locality %9.1f, walk %6.2f ns/elem (%lld)\n",
+           elems_num, use_free_map ? "on" : "off",
+           insert_time * 1e9 / (double)(ROUNDS_NUM * positions.size()), locality,
+           walk_time * 1e9 / (double)list.size, sum % 3);
+
+    list_dtor(&list);
+}
+
+/**
+ * @brief Compares link locality and walk time after churn with and without free slot map
+ */
+int main() {
+    for (list_idx_t elems_num = 1 << 16; elems_num <= 1 << 20; elems_num <<= 4) {
+        bench_free_map_churn(elems_num, false);
+        bench_free_map_churn(elems_num, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+
+#include <vector>
+#include <random>
+#include <sys/resource.h>
+
+#include "bench_utils.h"
+
+ListLogFileData list_log_file = {"log"};
+
+static const list_idx_t ELEMS_NUM = 1 << 23;
+
+/**
+ * @brief Returns peak resident set size in MiB
+ *
+ * @return long
+ */
+static long peak_rss_mib() {
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss / 1024;
+}
+
+/**
+ * @brief Measures time and peak RSS of one list_linearise call on List<int> built by inserts
+ *        after random elements. Two-buffer linearise is measured by building this file
+ *        against the tree before "Linearise list in place"
+ */
+int main() {
+    List<int> list = {};
+    list_ctor(&list, (size_t)ELEMS_NUM + 8);
+
+    std::mt19937 rng(1);
+    std::vector<list_idx_t> inserted = {};
+    inserted.reserve((size_t)ELEMS_NUM);
+
+    for (list_idx_t i = 0; i < ELEMS_NUM; i++) {
+        const list_idx_t position = inserted.empty() ? 0 : inserted[rng() % inserted.size()];
+
+        list_idx_t index = 0;
+        list_insert_after(&list, position, (int)i, &index);
+
+        inserted.push_back(index);
+    }
+
+    std::vector<list_idx_t>().swap(inserted);
+
+    const long rss_before = peak_rss_mib();
+    const double start = bench_now();
+
+    list_linearise(&list);
+
+    const double end = bench_now();
+
+    printf("linearise %" LIST_IDX_PRI " nodes: %.0f ms, peak RSS %ld -> %ld MiB\n",
+           ELEMS_NUM, (end - start) * 1e3, rss_before, peak_rss_mib());
+
+    list_dtor(&list);
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+
+#include <string.h>
+
+#include "bench_utils.h"
+
+ListLogFileData list_log_file = {"log"};
+
+static const int DUMPS_NUM = 300;
+static const int LINES_NUM = 100000;
+
+/**
+ * @brief Measures list_dump and list_log_printf throughput of per-call or persistent (argument
+ *        "persistent") log. list_dump exists only in debug build, so it is measured with
+ *        make bench bench_debug=1
+ */
+int main(int argc, const char* argv[]) {
+    list_log_file.is_persistent = argc > 1 && strcmp(argv[1], "persistent") == 0;
+
+#ifndef NDEBUG
+    List<int> list = {};
+    list_ctor(&list, 64);
+
+    list_idx_t index = 0;
+    for (int i = 0; i < 50; i++)
+        list_insert_after(&list, 0, i, &index);
+
+    const double dumps_start = bench_now();
+
+    for (int i = 0; i < DUMPS_NUM; i++)
+        list_dump(&list, VAR_CODE_DATA());
+
+    const double dumps_end = bench_now();
+
+    printf("%-10s list_dump: %8.1f dumps/s\n", list_log_file.is_persistent ? "persistent" : "per-call",
+           DUMPS_NUM / (dumps_end - dumps_start));
+
+    list_dtor(&list);
+#endif //< #ifndef NDEBUG
+
+    const double lines_start = bench_now();
+
+    for (int i = 0; i < LINES_NUM; i++)
+        list_log_printf(&list_log_file, "    line %d of plain log output\n", i);
+
+    const double lines_end = bench_now();
+
+    printf("%-10s list_log_printf: %10.0f lines/s\n", list_log_file.is_persistent ? "persistent" : "per-call",
+           LINES_NUM / (lines_end - lines_start));
+
+    return 0;
+}
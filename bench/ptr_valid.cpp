@@ -0,0 +1,58 @@
+#include "../src/list_log/list_log.h"
+#include "../src/utils/ptr_valid.h"
+
+#include <stdlib.h>
+#include <sys/mman.h>
+
+#include "bench_utils.h"
+
+// benchmarks are linked with whole list library
+ListLogFileData list_log_file = {"log"};
+
+static const int CALLS_NUM = 20000;
+
+/**
+ * @brief Prints time of one is_ptr_valid call
+ *
+ * @param name
+ * @param ptr
+ */
+static void bench_ptr_valid(const char* name, void* ptr) {
+    int valid_num = 0;
+
+    const double start = bench_now();
+
+    for (int i = 0; i < CALLS_NUM; i++)
+        valid_num += is_ptr_valid(ptr);
+
+    const double end = bench_now();
+
+    printf("%-10s valid = %d: %10.1f ns per call\n", name, valid_num == CALLS_NUM,
+           (end - start) * 1e9 / CALLS_NUM);
+}
+
+/**
+ * @brief Measures is_ptr_valid on valid pointers, null page and unmapped page
+ */
+int main() {
+    void* heap = malloc(1 << 20);
+    int stack_var = 0;
+
+    // page, that was mapped and then unmapped, is outside of every readable range
+    void* unmapped = mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (heap == nullptr || unmapped == MAP_FAILED || munmap(unmapped, 4096) != 0) {
+        fprintf(stderr, "Allocation error\n");
+        free(heap);
+        return 1;
+    }
+
+    bench_ptr_valid("heap",      heap);
+    bench_ptr_valid("stack",     &stack_var);
+    bench_ptr_valid("null",      nullptr);
+    bench_ptr_valid("null page", (void*)16);
+    bench_ptr_valid("unmapped",  unmapped);
+
+    free(heap);
+    return 0;
+}
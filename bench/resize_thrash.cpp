@@ -0,0 +1,86 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+
+#include <stdlib.h>
+
+#include "bench_utils.h"
+
+ListLogFileData list_log_file = {"log"};
+
+static const long OPS_NUM = 200000;
+
+static long reallocs_num = 0;
+
+// heap allocator, that counts data block reallocations
+
+static void* counting_alloc_(void* context, const size_t size) {
+    (void) context;
+
+    return calloc(1, size);
+}
+
+static void* counting_realloc_(void* context, void* ptr, const size_t old_size, const size_t new_size) {
+    (void) context;
+    (void) old_size;
+
+    reallocs_num++;
+
+    return realloc(ptr, new_size);
+}
+
+static void counting_free_(void* context, void* ptr, const size_t size) {
+    (void) context;
+    (void) size;
+
+    free(ptr);
+}
+
+/**
+ * @brief Pushes and pops OPS_NUM elements, while list size stays at capacity boundary
+ *
+ * @param size list size before each push
+ * @param is_pop_head pop element from head (queue) or from tail (stack)
+ */
+static void bench_resize_thrash(const list_idx_t size, const bool is_pop_head) {
+    List<long> list = {};
+
+    list.allocator.alloc   = counting_alloc_;
+    list.allocator.realloc = counting_realloc_;
+    list.allocator.free    = counting_free_;
+
+    list_ctor(&list, 2);
+
+    list_idx_t index = 0;
+    for (list_idx_t i = 0; i < size; i++)
+        list_pushback(&list, (long)i, &index);
+
+    reallocs_num = 0;
+
+    const double start = bench_now();
+
+    for (long i = 0; i < OPS_NUM; i++) {
+        list_pushback(&list, i, &index);
+        list_delete(&list, is_pop_head ? list_head(&list) : list_tail(&list));
+    }
+
+    const double end = bench_now();
+
+    printf("size %8" LIST_IDX_PRI ", pop %s: %8.2f ms, %7ld reallocs, capacity %" LIST_IDX_PRI "\n",
+           size, is_pop_head ? "head" : "tail", (end - start) * 1e3, reallocs_num, list.capacity);
+
+    list_dtor(&list);
+}
+
+/**
+ * @brief Reproduces resize thrash: pushback and pop, while size is at capacity boundary. Every push
+ *        used to grow list and every pop to shrink it. Old policy is measured by building this
+ *        file against the tree before "Add resize policy with shrink hysteresis"
+ */
+int main() {
+    for (list_idx_t size = 1 << 16; size <= 1 << 20; size <<= 4) {
+        bench_resize_thrash(size - 1, false);
+        bench_resize_thrash(size - 1, true);
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+
+#include <vector>
+#include <random>
+
+#include "bench_utils.h"
+
+ListLogFileData list_log_file = {"log"};
+
+static const list_idx_t ELEMS_NUM = 1 << 20;
+static const int        PASSES    = 20;
+
+/**
+ * @brief Measures LIST_FOREACH and list_find_by_value miss on linear and shuffled List<int>.
+ *        Compare make bench and make bench soa=1 (AoS and SoA layouts)
+ */
+int main() {
+#ifdef LIST_SOA
+    printf("SoA layout, %" LIST_IDX_PRI " elements\n", ELEMS_NUM);
+#else //< #ifndef LIST_SOA
+    printf("AoS layout (%zu B node), %" LIST_IDX_PRI " elements\n", sizeof(ListNode<int>), ELEMS_NUM);
+#endif //< #ifdef LIST_SOA
+
+    for (int is_shuffled = 0; is_shuffled < 2; is_shuffled++) {
+        List<int> list = {};
+        list_ctor(&list, (size_t)ELEMS_NUM * 2);
+
+        // shuffled list is built by inserts after random elements
+        std::mt19937 rng(1);
+        std::vector<list_idx_t> inserted = {};
+
+        for (list_idx_t i = 0; i < ELEMS_NUM; i++) {
+            const list_idx_t position = (is_shuffled && !inserted.empty())
+                                        ? inserted[rng() % inserted.size()] : list_tail(&list);
+            list_idx_t index = 0;
+            list_insert_after(&list, position, (int)i, &index);
+
+            inserted.push_back(index);
+        }
+
+        const double start = bench_now();
+
+        long long sum = 0;
+        for (int pass = 0; pass < PASSES; pass++) {
+            list_idx_t phys_i = list_head(&list);
+            list_idx_t log_i = 0;
+
+            LIST_FOREACH(list, phys_i, log_i)
+                sum += list_elem(&list, phys_i);
+        }
+
+        const double foreach_end = bench_now();
+
+        for (int pass = 0; pass < PASSES; pass++) {
+            list_idx_t found = 0;
+            list_find_by_value(&list, -1 - pass, &found);
+        }
+
+        const double find_end = bench_now();
+
+        printf("%-8s: LIST_FOREACH %7.2f ms/pass, find miss %7.2f ms/call (%lld)\n",
+               is_shuffled ? "shuffled" : "linear", (foreach_end - start) / PASSES * 1e3,
+               (find_end - foreach_end) / PASSES * 1e3, sum);
+
+        list_dtor(&list);
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+#include "../src/list_value_index.h"
+
+#include <vector>
+#include <random>
+
+#include "bench_utils.h"
+
+ListLogFileData list_log_file = {"log"};
+
+/**
+ * @brief Measures one hit, one miss, then delete and reinsert of the hit on non-linear List<int>
+ *        of distinct values
+ *
+ * @param elems_num
+ * @param is_indexed list_value_index_enable is called
+ * @param iters_num
+ */
+static void bench_value_index(const list_idx_t elems_num, const bool is_indexed, const int iters_num) {
+    List<int> list = {};
+    list_ctor(&list, (size_t)elems_num + 8);
+
+    if (is_indexed)
+        list_value_index_enable(&list);
+
+    std::mt19937 rng(1);
+    std::vector<list_idx_t> inserted = {};
+    inserted.reserve((size_t)elems_num);
+
+    list_idx_t index = 0;
+
+    for (list_idx_t i = 0; i < elems_num; i++) {
+        const list_idx_t position = inserted.empty() ? 0 : inserted[rng() % inserted.size()];
+
+        list_insert_after(&list, position, (int)i, &index);
+
+        inserted.push_back(index);
+    }
+
+    const double start = bench_now();
+
+    long long sum = 0;
+    for (int iter = 0; iter < iters_num; iter++) {
+        const int value = (int)(rng() % (unsigned)elems_num);
+
+        list_idx_t hit = 0;
+        list_find_by_value(&list, value, &hit);
+
+        list_idx_t miss = 0;
+        list_find_by_value(&list, (int)elems_num + value, &miss);
+
+        const list_idx_t prev = list_prev(&list, hit);
+
+        list_delete(&list, hit, true);
+        list_insert_after(&list, prev, value, &index);
+
+        sum += miss + index;
+    }
+
+    const double end = bench_now();
+
+    printf("n = %9" LIST_IDX_PRI " %-4s: %12.3f us per iteration (%lld)\n", elems_num,
+           is_indexed ? "hash" : "scan", (end - start) * 1e6 / iters_num, sum & 1);
+
+    list_dtor(&list);
+}
+
+/**
+ * @brief Compares list_find_by_value with and without value index on 1e3..1e7 elements
+ */
+int main() {
+    for (list_idx_t elems_num = 1000; elems_num <= 10000000; elems_num *= 10) {
+        bench_value_index(elems_num, false, elems_num >= 1000000 ? 20 : 2000);
+        bench_value_index(elems_num, true,  100000);
+    }
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "list.h"
+#include "list_order_index.h"
 
 #include "list_log/list_log.h"
 #include "utils/html.h"
@@ -9,11 +10,415 @@ extern ListLogFileData list_log_file;
 
 #ifndef NDEBUG
 
+/**
+ * @brief Dumped part of list: one slot, run of slots or skipped part
+ */
+struct ListDumpItem {
+    enum Kind {
+        SLOT        = 0,
+        LINEAR_RUN  = 1,    //< slots [first, last] are linked sequentially
+        FREE_RUN    = 2,    //< slots [first, last] are free
+        GAP         = 3,    //< skipped slots (physical modes) or elements (logical modes)
+    };
+
+    Kind kind = SLOT;
+
+    list_idx_t first = -1;  //< first physical index (-1 for logical gaps)
+    list_idx_t last  = -1;  //< last physical index (-1 for logical gaps)
+
+    list_idx_t skipped = 0; //< number of skipped slots or elements
+};
+
+/**
+ * @brief Dumped items in display order
+ */
+struct ListDumpItems {
+    ListDumpItem* items = nullptr;
+    size_t num = 0;
+    size_t cap = 0;
+
+    bool is_physical = false;   //< items are sorted by physical index
+};
+
+/**
+ * @brief Adds item to the end of items
+ *
+ * @param items
+ * @param item
+ * @return true success
+ * @return false allocation error
+ */
+static bool list_dump_items_push_(ListDumpItems* items, const ListDumpItem item) {
+    assert(items);
+
+    if (items->num == items->cap) {
+        const size_t new_cap = items->cap == 0 ? 64 : items->cap * 2;
+
+        ListDumpItem* new_items = (ListDumpItem*)realloc(items->items, new_cap * sizeof(ListDumpItem));
+        if (new_items == nullptr)
+            return false;
+
+        items->items = new_items;
+        items->cap   = new_cap;
+    }
+
+    items->items[items->num++] = item;
+
+    return true;
+}
+
+/**
+ * @brief Pushes slot item
+ *
+ * @param items
+ * @param phys_i
+ * @return true success
+ * @return false allocation error
+ */
+static bool list_dump_items_push_slot_(ListDumpItems* items, const list_idx_t phys_i) {
+    ListDumpItem item = {};
+
+    item.kind  = ListDumpItem::SLOT;
+    item.first = phys_i;
+    item.last  = phys_i;
+
+    return list_dump_items_push_(items, item);
+}
+
+/**
+ * @brief Pushes gap item
+ *
+ * @param items
+ * @param first -1 for logical gaps
+ * @param last -1 for logical gaps
+ * @param skipped
+ * @return true success
+ * @return false allocation error
+ */
+static bool list_dump_items_push_gap_(ListDumpItems* items, const list_idx_t first, const list_idx_t last,
+                                      const list_idx_t skipped) {
+    ListDumpItem item = {};
+
+    item.kind    = ListDumpItem::GAP;
+    item.first   = first;
+    item.last    = last;
+    item.skipped = skipped;
+
+    return list_dump_items_push_(items, item);
+}
+
+/**
+ * @brief Reverses items [from, num)
+ *
+ * @param items
+ * @param from
+ */
+static void list_dump_items_reverse_(ListDumpItems* items, size_t from) {
+    assert(items);
+
+    for (size_t to = items->num; from + 1 < to; from++, to--) {
+        const ListDumpItem tmp = items->items[from];
+
+        items->items[from]   = items->items[to - 1];
+        items->items[to - 1] = tmp;
+    }
+}
+
+/**
+ * @brief Returns position of item, that contains phys_i, or -1
+ *
+ * @param items
+ * @param phys_i
+ * @return long
+ */
+static long list_dump_item_of_(const ListDumpItems* items, const list_idx_t phys_i) {
+    assert(items);
+
+    if (items->is_physical) {
+        size_t left = 0;
+        size_t right = items->num;
+
+        while (left < right) {
+            const size_t mid = left + (right - left) / 2;
+
+            if (items->items[mid].last < phys_i)
+                left = mid + 1;
+            else
+                right = mid;
+        }
+
+        if (left < items->num && items->items[left].first <= phys_i)
+            return (long)left;
+
+        return -1;
+    }
+
+    for (size_t i = 0; i < items->num; i++)
+        if (items->items[i].kind == ListDumpItem::SLOT && items->items[i].first == phys_i)
+            return (long)i;
+
+    return -1;
+}
+
+/**
+ * @brief Returns dump mode with AUTO resolved
+ *
+ * @param list
+ * @param params
+ * @return ListDumpParams::Mode
+ */
+template <typename T>
+static ListDumpParams::Mode list_dump_mode_(const List<T>* list, const ListDumpParams* params) {
+    assert(list);
+    assert(params);
+
+    if (params->mode != ListDumpParams::AUTO)
+        return params->mode;
+
+    return list->capacity <= params->AUTO_FULL_MAX_CAPACITY ? ListDumpParams::FULL : ListDumpParams::ENDS;
+}
+
+/**
+ * @brief Returns next slot in walk direction or -1 if link is damaged
+ *
+ * @param list
+ * @param phys_i
+ * @param forward
+ * @return list_idx_t
+ */
+template <typename T>
+static list_idx_t list_dump_step_(const List<T>* list, const list_idx_t phys_i, const bool forward) {
+    assert(list);
+
+    const list_idx_t step = forward ? list_next(list, phys_i) : list_prev(list, phys_i);
+
+    return (step < 0 || step >= list->capacity) ? -1 : step;
+}
+
+/**
+ * @brief Pushes at most num elements starting from phys_i. List is walked without verification,
+ *        because list may be damaged
+ *
+ * @param list
+ * @param items
+ * @param phys_i
+ * @param num
+ * @param forward walk direction
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_dump_push_walk_(const List<T>* list, ListDumpItems* items, list_idx_t phys_i,
+                                 list_idx_t num, const bool forward) {
+    assert(list);
+    assert(items);
+
+    while (num-- > 0 && phys_i > 0) {
+        if (!list_dump_items_push_slot_(items, phys_i))
+            return false;
+
+        phys_i = list_dump_step_(list, phys_i, forward);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Finds physical index of element without verification. Linear prefix gives it in O(1),
+ *        valid order index in O(sqrt(n)). Otherwise list is walked from the nearer end
+ *
+ * @param list
+ * @param logical_i
+ * @return list_idx_t physical index. -1 if list is damaged
+ */
+template <typename T>
+static list_idx_t list_dump_find_logical_(const List<T>* list, const list_idx_t logical_i) {
+    assert(list);
+    assert(0 <= logical_i && logical_i < list->size);
+
+    if (logical_i < list->linear_prefix)
+        return list_linear_phys(list, logical_i);
+
+    list_idx_t phys_i = -1;
+
+    // invalid index isn't rebuilt: rebuild walks list, that may be damaged
+    if (list->order_index != nullptr && list->order_index->is_valid &&
+        list_order_index_find(list, logical_i, &phys_i))
+        return (0 < phys_i && phys_i < list->capacity) ? phys_i : -1;
+
+    const bool forward = logical_i <= list->size / 2;
+
+    // slot 0 links to head and tail
+    phys_i = list_dump_step_(list, 0, forward);
+
+    const list_idx_t steps = forward ? logical_i : list->size - 1 - logical_i;
+
+    for (list_idx_t step_i = 0; step_i < steps && phys_i > 0; step_i++)
+        phys_i = list_dump_step_(list, phys_i, forward);
+
+    return phys_i;
+}
+
+/**
+ * @brief Selects dumped items. Only FULL mode is O(capacity)
+ *
+ * @param list
+ * @param params
+ * @param items
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_dump_select_(const List<T>* list, const ListDumpParams* params, ListDumpItems* items) {
+    assert(list);
+    assert(params);
+    assert(items);
+
+    const list_idx_t k = MAX(params->k, 1);
+
+    // slots over free_watermark aren't initialised. Damaged free_watermark is clamped to capacity
+    const list_idx_t used_end = MIN(MAX(list->free_watermark, 1), list->capacity);
+
+    if (!list_dump_items_push_slot_(items, 0))
+        return false;
+
+    switch (list_dump_mode_(list, params)) {
+        case ListDumpParams::AUTO:
+        case ListDumpParams::FULL:
+            items->is_physical = true;
+
+            for (list_idx_t phys_i = 1; phys_i < used_end; phys_i++) {
+                const bool is_free = list_is_free(list, phys_i);
+                list_idx_t last = phys_i;
+
+                if (params->collapse_runs) {
+                    while (last + 1 < used_end && list_is_free(list, last + 1) == is_free &&
+                           (is_free || list_next(list, last) == last + 1))
+                        last++;
+                }
+
+                ListDumpItem item = {};
+
+                item.kind  = last == phys_i ? ListDumpItem::SLOT :
+                             is_free        ? ListDumpItem::FREE_RUN : ListDumpItem::LINEAR_RUN;
+                item.first = phys_i;
+                item.last  = last;
+
+                if (!list_dump_items_push_(items, item))
+                    return false;
+
+                phys_i = last;
+            }
+
+            // slots over free_watermark are shown as one free run
+            if (used_end < list->capacity) {
+                ListDumpItem item = {};
+
+                item.kind  = ListDumpItem::FREE_RUN;
+                item.first = used_end;
+                item.last  = list->capacity - 1;
+
+                if (!list_dump_items_push_(items, item))
+                    return false;
+            }
+
+            return true;
+
+        case ListDumpParams::WINDOW_PHYSICAL: {
+            items->is_physical = true;
+
+            // slots over free_watermark are skipped
+            const list_idx_t last  = MIN(params->index + k, used_end - 1);
+            const list_idx_t first = MIN(MAX(params->index - k, 1), last + 1);
+
+            if (first > 1 && !list_dump_items_push_gap_(items, 1, first - 1, first - 1))
+                return false;
+
+            for (list_idx_t phys_i = first; phys_i <= last; phys_i++)
+                if (!list_dump_items_push_slot_(items, phys_i))
+                    return false;
+
+            if (last < list->capacity - 1 &&
+                !list_dump_items_push_gap_(items, last + 1, list->capacity - 1, list->capacity - 1 - last))
+                return false;
+
+            return true;
+        }
+
+        case ListDumpParams::WINDOW_LOGICAL: {
+            if (list->size == 0)
+                return true;
+
+            const list_idx_t center = MIN(MAX(params->index, 0), list->size - 1);
+
+            const list_idx_t center_i = list_dump_find_logical_(list, center);
+
+            if (center_i <= 0)
+                return true;
+
+            const list_idx_t before = MIN(k, center);
+            const list_idx_t after  = MIN(k, list->size - 1 - center);
+
+            if (center - before > 0 && !list_dump_items_push_gap_(items, -1, -1, center - before))
+                return false;
+
+            const size_t reversed_from = items->num;
+
+            if (!list_dump_push_walk_(list, items, center_i, before + 1, false))
+                return false;
+
+            list_dump_items_reverse_(items, reversed_from);
+
+            if (!list_dump_push_walk_(list, items, list_dump_step_(list, center_i, true), after, true))
+                return false;
+
+            if (center + after < list->size - 1 &&
+                !list_dump_items_push_gap_(items, -1, -1, list->size - 1 - center - after))
+                return false;
+
+            return true;
+        }
+
+        case ListDumpParams::ENDS: {
+            if (list->size <= 2 * k)
+                return list_dump_push_walk_(list, items, list_head(list), list->size, true);
+
+            if (!list_dump_push_walk_(list, items, list_head(list), k, true))
+                return false;
+
+            if (!list_dump_items_push_gap_(items, -1, -1, list->size - 2 * k))
+                return false;
+
+            const size_t reversed_from = items->num;
+
+            if (!list_dump_push_walk_(list, items, list_tail(list), k, false))
+                return false;
+
+            list_dump_items_reverse_(items, reversed_from);
+
+            return true;
+        }
+
+        default:
+            assert(0 && "Invalid dump mode");
+            return false;
+    }
+}
+
+template <typename T>
+static bool list_dump_dot_items_(const List<T>* list, char* img_filename, const ListDumpItems* items);
+
 #define LOG_(...) list_log_printf(&list_log_file, __VA_ARGS__)
 
-void list_dump(const List* list, const VarCodeData call_data) {
+template <typename T>
+void list_dump(const List<T>* list, const VarCodeData call_data, const ListDumpParams params) {
     assert(list);
 
+    if (list_dump_ring_is_active()) {
+        list_dump_ring_push(list, call_data, params);
+        return;
+    }
+
     LOG_(HTML_BEGIN);
 
     LOG_("    list_dump() called from %s:%d %s\n"
@@ -22,16 +427,31 @@ void list_dump(const List* list, const VarCodeData call_data) {
          list->var_data.name, list,
          list->var_data.file, list->var_data.line, list->var_data.func);
 
+    // head and tail are stored in data block
+    const bool is_data_valid = is_ptr_valid(list_data(list));
+
     LOG_("    {\n");
-    LOG_("    real capacity  = %zd\n", list->capacity);
-    LOG_("    size           = %zd\n", list->size);
-    LOG_("    head           = %zd\n", list_head(list));
-    LOG_("    tail           = %zd\n", list_tail(list));
-    LOG_("    free_head      = %zd\n", list->free_head);
+    LOG_("    real capacity  = %" LIST_IDX_PRI "\n", list->capacity);
+    LOG_("    size           = %" LIST_IDX_PRI "\n", list->size);
+    LOG_("    head           = %" LIST_IDX_PRI "\n", is_data_valid ? list_head(list) : -1);
+    LOG_("    tail           = %" LIST_IDX_PRI "\n", is_data_valid ? list_tail(list) : -1);
+    LOG_("    free_head      = %" LIST_IDX_PRI "\n", list->free_head);
+    LOG_("    free_watermark = %" LIST_IDX_PRI "\n", list->free_watermark);
     LOG_("    is_linear      = %s\n",  list->is_linear ? "true" : "false");
+    LOG_("    linear_prefix  = %" LIST_IDX_PRI "\n", list->linear_prefix);
+    LOG_("    linear_offset  = %" LIST_IDX_PRI "\n", list->linear_offset);
+    LOG_("    resize_policy  = growth x%.2f, shrink under %.1f%% load, min capacity %" LIST_IDX_PRI ", auto shrink %s\n",
+         list->resize_policy.growth_factor, 100.0 * list->resize_policy.shrink_load,
+         list->resize_policy.min_capacity, list->resize_policy.auto_shrink ? "on" : "off");
+
+    if (list->capacity > 1)
+        LOG_("    load           = %.1f%%, linear part = %.1f%%\n",
+             100.0 * (double)list->size / (double)(list->capacity - 1),
+             list->size > 0 ? 100.0 * (double)list->linear_prefix / (double)list->size : 100.0);
+
     LOG_("        {\n");
 
-    if (!is_ptr_valid(list->arr)) {
+    if (!is_data_valid) {
 
         if (list_is_initialised(list))
             LOG_(HTML_RED("        can't read (invalid pointer)\n"));
@@ -41,28 +461,101 @@ void list_dump(const List* list, const VarCodeData call_data) {
         return;
     }
 
+    ListDumpItems items = {};
+
+    if (!list_dump_select_(list, &params, &items)) {
+        LOG_(HTML_RED("        can't select dumped nodes (allocation error)\n"));
+        LOG_("        }\n"
+             "    }\n" HTML_END);
+
+        free(items.items);
+        return;
+    }
+
     LOG_("        ""  i | prev | next | elem\n");
 
-    for (ssize_t i = 0; i < list->capacity; i++) {
-        LOG_("        ""%3zd | %4zd | %4zd | " ELEM_T_PRINTF "\n",
-             i, list->arr[i].prev, list->arr[i].next, list->arr[i].elem);
+    char elem_str [LIST_ELEM_MAX_PRINT_LEN] = {};
+    char elem_str2[LIST_ELEM_MAX_PRINT_LEN] = {};
+
+    for (size_t item_i = 0; item_i < items.num; item_i++) {
+        const ListDumpItem* item = &items.items[item_i];
+
+        switch (item->kind) {
+            case ListDumpItem::SLOT:
+                ListElemTraits<T>::print(elem_str, LIST_ELEM_MAX_PRINT_LEN, list_elem(list, item->first));
+
+                LOG_("        ""%3" LIST_IDX_PRI " | %4" LIST_IDX_PRI " | %4" LIST_IDX_PRI " | %s\n",
+                     item->first, list_prev(list, item->first), list_next(list, item->first), elem_str);
+                break;
+
+            case ListDumpItem::LINEAR_RUN:
+                ListElemTraits<T>::print(elem_str,  LIST_ELEM_MAX_PRINT_LEN, list_elem(list, item->first));
+                ListElemTraits<T>::print(elem_str2, LIST_ELEM_MAX_PRINT_LEN, list_elem(list, item->last));
+
+                LOG_("        ""%3" LIST_IDX_PRI "..%" LIST_IDX_PRI " | linear run of %" LIST_IDX_PRI
+                     " elements: %s .. %s\n",
+                     item->first, item->last, item->last - item->first + 1, elem_str, elem_str2);
+                break;
+
+            case ListDumpItem::FREE_RUN:
+                LOG_("        ""%3" LIST_IDX_PRI "..%" LIST_IDX_PRI " | %" LIST_IDX_PRI " free slots\n",
+                     item->first, item->last, item->last - item->first + 1);
+                break;
+
+            case ListDumpItem::GAP:
+                LOG_("        ""... | %" LIST_IDX_PRI " %s skipped\n",
+                     item->skipped, item->first == -1 ? "elements" : "slots");
+                break;
+
+            default:
+                assert(0 && "Invalid dump item");
+                break;
+        }
     }
 
     LOG_("        }\n");
 
-    LOG_("    Ordered elements:");
+    const ListDumpParams::Mode mode = list_dump_mode_(list, &params);
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
-    LIST_FOREACH(*list, phys_i, log_i) {
-        LOG_(" " ELEM_T_PRINTF, list->arr[phys_i].elem);
-    }
-    LOG_("\n    Physical indexes:");
+    if (mode == ListDumpParams::FULL && !params.collapse_runs) {
+        LOG_("    Ordered elements:");
+
+        list_idx_t phys_i = list_head(list);
+        list_idx_t log_i = 0;
+        LIST_FOREACH(*list, phys_i, log_i) {
+            ListElemTraits<T>::print(elem_str, LIST_ELEM_MAX_PRINT_LEN, list_elem(list, phys_i));
+
+            LOG_(" %s", elem_str);
+        }
+        LOG_("\n    Physical indexes:");
+
+        phys_i = list_head(list);
+        log_i = 0;
+        LIST_FOREACH(*list, phys_i, log_i) {
+            LOG_(" %" LIST_IDX_PRI, phys_i);
+        }
+    } else if (mode == ListDumpParams::WINDOW_LOGICAL || mode == ListDumpParams::ENDS) {
+        // items are in logical order
+        LOG_("    Ordered elements:");
 
-    phys_i = list_head(list);
-    log_i = 0;
-    LIST_FOREACH(*list, phys_i, log_i) {
-        LOG_(" %zu", phys_i);
+        for (size_t item_i = 1; item_i < items.num; item_i++) {
+            if (items.items[item_i].kind == ListDumpItem::GAP) {
+                LOG_(" ...");
+                continue;
+            }
+
+            ListElemTraits<T>::print(elem_str, LIST_ELEM_MAX_PRINT_LEN, list_elem(list, items.items[item_i].first));
+
+            LOG_(" %s", elem_str);
+        }
+        LOG_("\n    Physical indexes:");
+
+        for (size_t item_i = 1; item_i < items.num; item_i++) {
+            if (items.items[item_i].kind == ListDumpItem::GAP)
+                LOG_(" ...");
+            else
+                LOG_(" %" LIST_IDX_PRI, items.items[item_i].first);
+        }
     }
 
     LOG_("\n"
@@ -70,14 +563,87 @@ void list_dump(const List* list, const VarCodeData call_data) {
 
     char img_filename[list_log_file.MAX_FILENAME_LEN] = {};
 
-    list_dump_dot(list, img_filename);
+    if (list_dump_dot_items_(list, img_filename, &items))
+        LOG_("<img src=\"../../%s\">\n", img_filename);
 
-    LOG_("<img src=\"../../%s\">\n", img_filename);
+    free(items.items);
 }
 #undef LOG_
 
+template <typename T>
+bool list_dump_dot(const List<T>* list, char* img_filename, const ListDumpParams params) {
+    assert(list);
+    assert(img_filename);
+
+    ListDumpItems items = {};
+
+    bool res = list_dump_select_(list, &params, &items) && list_dump_dot_items_(list, img_filename, &items);
+
+    free(items.items);
+
+    return res;
+}
+
+/**
+ * @brief Writes dot node name of item
+ *
+ * @param buf
+ * @param items
+ * @param item_i
+ */
+static void list_dump_dot_name_(char* buf, const ListDumpItems* items, const size_t item_i) {
+    assert(buf);
+    assert(items);
+
+    static const size_t MAX_NAME_LEN = 64;
+
+    // slots and runs are named by first slot, so edges to any slot of run lead to run
+    if (items->items[item_i].kind == ListDumpItem::GAP)
+        snprintf(buf, MAX_NAME_LEN, "gap_%zu", item_i);
+    else
+        snprintf(buf, MAX_NAME_LEN, "elem_%" LIST_IDX_PRI, items->items[item_i].first);
+}
+
 #define FPRINTF_(...) if (fprintf(file, __VA_ARGS__) == 0) return false
-bool list_dump_dot(const List* list, char* img_filename) {
+
+/**
+ * @brief Writes edge from node to item containing phys_i. Slots, that aren't dumped, are
+ *        drawn as plain text nodes
+ *
+ * @param file
+ * @param items
+ * @param from node name
+ * @param phys_i
+ * @param attrs edge attributes
+ * @return true success
+ * @return false failure
+ */
+static bool list_dump_dot_edge_(FILE* file, const ListDumpItems* items, const char* from,
+                                const list_idx_t phys_i, const char* attrs) {
+    assert(file);
+    assert(items);
+    assert(from);
+    assert(attrs);
+
+    char to[64] = {};
+
+    const long item_i = list_dump_item_of_(items, phys_i);
+
+    if (item_i == -1) {
+        snprintf(to, sizeof(to), "out_%" LIST_IDX_PRI, phys_i);
+
+        FPRINTF_("%s [shape=plaintext, fontcolor=white, label=\"%" LIST_IDX_PRI "\"];\n", to, phys_i);
+    } else {
+        list_dump_dot_name_(to, items, (size_t)item_i);
+    }
+
+    FPRINTF_("%s->%s [%s];\n", from, to, attrs);
+
+    return true;
+}
+
+template <typename T>
+static bool list_dump_dot_items_(const List<T>* list, char* img_filename, const ListDumpItems* items) {
     #define BACKGROUND_COLOR "\"#1f1f1f\""
     #define FONT_COLOR       "\"#000000\""
     #define NODE_PREFIX      "elem_"
@@ -85,6 +651,7 @@ bool list_dump_dot(const List* list, char* img_filename) {
     #define ZERO_NODE_PARAMS "shape=\"plaintext\", style=\"filled\", fillcolor=\"#6e7681\", color=yellow"
 
     assert(list);
+    assert(items);
 
     static size_t dot_number = 0;
 
@@ -98,69 +665,115 @@ bool list_dump_dot(const List* list, char* img_filename) {
     if (file == nullptr)
         return false;
 
+    char elem_str [LIST_ELEM_MAX_PRINT_LEN] = {};
+    char elem_str2[LIST_ELEM_MAX_PRINT_LEN] = {};
+
+    char name[64] = {};
+
     FPRINTF_("digraph List{\n"
              "    graph [bgcolor=" BACKGROUND_COLOR ", splines=ortho];\n"
              "    node[color=white, fontcolor=" FONT_COLOR ", fontsize=14, fontname=\"verdana\"];\n\n");
 
     FPRINTF_(NODE_PREFIX "0 [" ZERO_NODE_PARAMS ", label=< <table cellspacing=\"0\">\n"
-                                                            "<tr><td>head = %zd </td></tr>\n"
-                                                            "<tr><td>tail = %zd </td></tr>\n"
-                                                            "<tr><td>free_tail = %zd</td></tr>\n"
+                                                            "<tr><td>head = %" LIST_IDX_PRI " </td></tr>\n"
+                                                            "<tr><td>tail = %" LIST_IDX_PRI " </td></tr>\n"
+                                                            "<tr><td>free_tail = %" LIST_IDX_PRI "</td></tr>\n"
                                                             "</table>>];\n\n",
              list_head(list), list_tail(list), list->free_head);
 
-    for (ssize_t phys_i = 1; phys_i < list->capacity; phys_i++) {
-        FPRINTF_(NODE_PREFIX "%zd [" NODE_PARAMS ", label=<<table cellspacing=\"0\">\n"
-                                                           "<tr><td colspan=\"2\">phys idx = %zd </td></tr>\n", phys_i, phys_i);
+    for (size_t item_i = 1; item_i < items->num; item_i++) {
+        const ListDumpItem* item = &items->items[item_i];
 
-        if (list->arr[phys_i].elem == ListNode::POISON) {
-            FPRINTF_("<tr><td colspan=\"2\">elem = PZN</td></tr>\n");
-        } else {
-            FPRINTF_("<tr><td colspan=\"2\">elem = " ELEM_T_PRINTF "</td></tr>\n", list->arr[phys_i].elem);
-        }
+        list_dump_dot_name_(name, items, item_i);
+
+        switch (item->kind) {
+            case ListDumpItem::SLOT:
+                FPRINTF_("%s [" NODE_PARAMS ", label=<<table cellspacing=\"0\">\n"
+                         "<tr><td colspan=\"2\">phys idx = %" LIST_IDX_PRI " </td></tr>\n", name, item->first);
+
+                if (list_is_poison(list_elem(list, item->first))) {
+                    FPRINTF_("<tr><td colspan=\"2\">elem = PZN</td></tr>\n");
+                } else {
+                    ListElemTraits<T>::print(elem_str, LIST_ELEM_MAX_PRINT_LEN, list_elem(list, item->first));
 
-        FPRINTF_("<tr><td>prev = %zd </td><td>next = %zd</td></tr></table>>", list->arr[phys_i].prev, list->arr[phys_i].next);
+                    FPRINTF_("<tr><td colspan=\"2\">elem = %s</td></tr>\n", elem_str);
+                }
 
-        if (list->arr[phys_i].prev == -1)
-            FPRINTF_(", color=yellow");
+                FPRINTF_("<tr><td>prev = %" LIST_IDX_PRI " </td><td>next = %" LIST_IDX_PRI "</td></tr></table>>",
+                         list_prev(list, item->first), list_next(list, item->first));
 
-        FPRINTF_("];\n\n");
+                if (list_is_free(list, item->first))
+                    FPRINTF_(", color=yellow");
+
+                FPRINTF_("];\n\n");
+                break;
+
+            case ListDumpItem::LINEAR_RUN:
+                ListElemTraits<T>::print(elem_str,  LIST_ELEM_MAX_PRINT_LEN, list_elem(list, item->first));
+                ListElemTraits<T>::print(elem_str2, LIST_ELEM_MAX_PRINT_LEN, list_elem(list, item->last));
+
+                FPRINTF_("%s [" NODE_PARAMS ", label=<<table cellspacing=\"0\">\n"
+                         "<tr><td>phys idx = %" LIST_IDX_PRI "..%" LIST_IDX_PRI " </td></tr>\n"
+                         "<tr><td>%" LIST_IDX_PRI " linear elements</td></tr>\n"
+                         "<tr><td>elem = %s .. %s</td></tr></table>>, color=green];\n\n",
+                         name, item->first, item->last, item->last - item->first + 1, elem_str, elem_str2);
+                break;
+
+            case ListDumpItem::FREE_RUN:
+                FPRINTF_("%s [" NODE_PARAMS ", label=<<table cellspacing=\"0\">\n"
+                         "<tr><td>phys idx = %" LIST_IDX_PRI "..%" LIST_IDX_PRI " </td></tr>\n"
+                         "<tr><td>%" LIST_IDX_PRI " free slots</td></tr></table>>, color=yellow];\n\n",
+                         name, item->first, item->last, item->last - item->first + 1);
+                break;
+
+            case ListDumpItem::GAP:
+                FPRINTF_("%s [shape=plaintext, fontcolor=white, label=\"... %" LIST_IDX_PRI " %s ...\"];\n\n",
+                         name, item->skipped, item->first == -1 ? "elements" : "slots");
+                break;
+
+            default:
+                assert(0 && "Invalid dump item");
+                break;
+        }
     }
 
     FPRINTF_("{rank=same;");
-    for (ssize_t phys_i = 0; phys_i < list->capacity; phys_i++) {
-        FPRINTF_(" " NODE_PREFIX "%zd", phys_i);
+    for (size_t item_i = 0; item_i < items->num; item_i++) {
+        list_dump_dot_name_(name, items, item_i);
+
+        FPRINTF_(" %s", name);
     }
     FPRINTF_("};\n");
 
-    for (ssize_t phys_i = 0; phys_i < list->capacity; phys_i++) {
-        if (phys_i != 0)
+    for (size_t item_i = 0; item_i < items->num; item_i++) {
+        if (item_i != 0)
             FPRINTF_("->");
 
-        FPRINTF_(NODE_PREFIX "%zd", phys_i);
+        list_dump_dot_name_(name, items, item_i);
+
+        FPRINTF_("%s", name);
     }
     FPRINTF_("[style=invis];\n\n");
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
+    #define EDGE_(phys_i_, attrs_)  if (!list_dump_dot_edge_(file, items, name, phys_i_, attrs_)) return false
 
-    LIST_FOREACH(*list, phys_i, log_i) {
-        if (list->arr[phys_i].next != 0)
-            FPRINTF_(NODE_PREFIX "%zd->" NODE_PREFIX "%zd [color=green, weight=0];\n", phys_i, list->arr[phys_i].next);
+    for (size_t item_i = 1; item_i < items->num; item_i++) {
+        const ListDumpItem* item = &items->items[item_i];
 
-        if (list->arr[phys_i].prev != 0)
-            FPRINTF_(NODE_PREFIX "%zd->" NODE_PREFIX "%zd [color=blue, weight=0];\n", phys_i, list->arr[phys_i].prev);
-    }
+        list_dump_dot_name_(name, items, item_i);
+
+        if (item->kind == ListDumpItem::SLOT && list_is_free(list, item->first)) {
+            if (list_next(list, item->first) != 0)
+                EDGE_(list_next(list, item->first), "color=yellow, weight=0");
 
-    phys_i = list->free_head;
-    log_i = 0;
-    // macros is not used because of different size clause
-    for (; phys_i > 0 && log_i <= list->capacity - list->size;
-           phys_i = list->arr[phys_i].next, log_i++) {
+        } else if (item->kind == ListDumpItem::SLOT || item->kind == ListDumpItem::LINEAR_RUN) {
+            // inner links of run are not drawn
+            if (list_next(list, item->last) != 0)
+                EDGE_(list_next(list, item->last), "color=green, weight=0");
 
-        if (list->arr[phys_i].next != 0)
-            FPRINTF_(NODE_PREFIX "%zd->" NODE_PREFIX "%zd [color=yellow, weight=0];\n",
-                                  phys_i,             list->arr[phys_i].next);
+            if (list_prev(list, item->first) != 0)
+                EDGE_(list_prev(list, item->first), "color=blue, weight=0");
+        }
     }
 
     FPRINTF_("head [shape=rect, label=\"HEAD\", color=yellow, fillcolor=\"#7293ba\",style=filled];\n");
@@ -168,9 +781,16 @@ bool list_dump_dot(const List* list, char* img_filename) {
     FPRINTF_("free_head [shape=rect, label=\"FREE_HEAD\","
                         "color=yellow, fillcolor=\"#7293ba\", style=filled];\n");
 
-    FPRINTF_("head->" NODE_PREFIX "%zd [color=yellow];\n", list_head(list));
-    FPRINTF_("tail->" NODE_PREFIX "%zd [color=yellow];\n", list_tail(list));
-    FPRINTF_("free_head->" NODE_PREFIX "%zd [color=yellow];\n", list->free_head);
+    snprintf(name, sizeof(name), "head");
+    EDGE_(list_head(list), "color=yellow");
+
+    snprintf(name, sizeof(name), "tail");
+    EDGE_(list_tail(list), "color=yellow");
+
+    snprintf(name, sizeof(name), "free_head");
+    EDGE_(list->free_head, "color=yellow");
+
+    #undef EDGE_
 
     FPRINTF_("}\n");
 
@@ -179,6 +799,16 @@ bool list_dump_dot(const List* list, char* img_filename) {
         return false;
     }
 
+    if (list_dot_log_is_async()) {
+        // svg name is known before it is rendered by background worker
+        if (snprintf(img_filename, list_log_file.MAX_FILENAME_LEN, "%s.svg", dot_filename) <= 0)
+            return false;
+
+        dot_number++;
+
+        return list_dot_log_queue_img(dot_filename);
+    }
+
     if (snprintf(img_filename, list_log_file.MAX_FILENAME_LEN, "%s%zd.svg",
                  list_log_file.timestamp_dir, dot_number++) <= 0)
         return false;
@@ -192,18 +822,26 @@ bool list_dump_dot(const List* list, char* img_filename) {
 }
 #undef FPRINTF_
 
+#define LIST_DUMP_INSTANTIATE_(T)                                                                       \
+    template void list_dump(const List<T>* list, const VarCodeData call_data, const ListDumpParams params); \
+    template bool list_dump_dot(const List<T>* list, char* img_filename, const ListDumpParams params);
+
+LIST_ELEM_TYPES(LIST_DUMP_INSTANTIATE_)
+
+#undef LIST_DUMP_INSTANTIATE_
+
 #endif //< #ifndef NDEBUG
 
-#define PRINT_ERR_(code, descr)  if ((err_code) & List::code)                                           \
+#define PRINT_ERR_(code, descr)  if ((err_code) & ListBase::code)                                           \
                                     list_log_printf(&list_log_file,                                     \
                                                     HTML_TEXT(HTML_RED("!!! " #code ": " descr "\n")));
 void list_print_error(const int err_code) {
-    if (err_code == List::OK) {
+    if (err_code == ListBase::OK) {
         list_log_printf(&list_log_file, HTML_TEXT(HTML_GREEN("No error\n")));
     } else {
         PRINT_ERR_(ALREADY_INITIALISED, "Constructor called for already initialised or corrupted list");
         PRINT_ERR_(UNITIALISED,         "List is not initialised");
-        PRINT_ERR_(DATA_INVALID_PTR,    "list.arr pointer is not valid for writing");
+        PRINT_ERR_(DATA_INVALID_PTR,    "list data pointer is not valid for writing");
         PRINT_ERR_(ALLOC_ERR,           "Can't allocate memory");
         PRINT_ERR_(POISON_VAL_FOUND,    "There is poison value in list");
         PRINT_ERR_(NON_POISON_EMPTY,    "Empty element is not poison");
@@ -213,10 +851,15 @@ void list_print_error(const int err_code) {
         PRINT_ERR_(NEGATIVE_SIZE,       "Negative list.size");
         PRINT_ERR_(INVALID_POSITION,    "Invalid physical index given");
         PRINT_ERR_(DAMAGED_PATH,        "List is damaged. Invalid path");
-        PRINT_ERR_(INVALID_FREE_HEAD,   "Invalid free_head field");
+        PRINT_ERR_(INVALID_FREE_HEAD,   "Invalid free_head or free_watermark field");
         PRINT_ERR_(INVALID_TAIL,        "Invalid tail field");
         PRINT_ERR_(INVALID_HEAD,        "Invalid head field");
-        PRINT_ERR_(INVALID_IS_LINEAR,   "is_linear flag is true, but list isn't linear");
+        PRINT_ERR_(INVALID_IS_LINEAR,   "is_linear flag or linear_prefix doesn't match list");
+        PRINT_ERR_(CAPACITY_OVERFLOW,   "Capacity doesn't fit in list_idx_t");
+        PRINT_ERR_(DAMAGED_FREE_LIST,   "Free list is damaged");
+        PRINT_ERR_(FILE_IO_ERR,         "Can't open, read, write or map file");
+        PRINT_ERR_(INVALID_FILE,        "File is damaged or saved by list with other build options");
+        PRINT_ERR_(INVALID_RESIZE_POLICY, "Invalid resize_policy (growth_factor <= 1 or shrink_load >= 1 / growth_factor)");
     }
 }
 #undef PRINT_ERR_
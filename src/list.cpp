@@ -1,4 +1,12 @@
 #include "list.h"
+#include "list_order_index.h"
+#include "list_value_index.h"
+#include "list_free_map.h"
+#include "list_scan.h"
+#include "list_file.h"
+#include "list_alloc.h"
+
+#include <time.h>
 
 #include "list_log/list_log.h"
 #include "utils/html.h"
@@ -14,59 +22,453 @@ extern ListLogFileData list_log_file;
                                                     return res;         \
                                                 }
 
-int list_ctor(List* list, size_t init_capacity) {
+/**
+ * @brief Allocates data block for capacity nodes (by list allocator or in list mapping) and assigns it
+ *        to list. Block isn't initialised
+ *
+ * @param list
+ * @param capacity
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_data_alloc_(List<T>* list, const size_t capacity) {
     assert(list);
+    assert((list->allocator.alloc == nullptr) == (list->allocator.free == nullptr));
 
-    int res = list->OK;
+    void* data = list->mapping.kind == ListMapping::NONE ?
+                 list_allocator_alloc(&list->allocator, list_data_size<T>(capacity)) :
+                 list_mapping_alloc(&list->mapping, list_data_size<T>(capacity));
 
-    CHECK_AND_RETURN(list_is_initialised(list), list->ALREADY_INITIALISED);
+    if (data == nullptr)
+        return false;
 
-    init_capacity++; //< fake element
+    list_data_assign(list, data, capacity);
+    return true;
+}
+
+/**
+ * @brief Frees list data block or unmaps mapping it is part of
+ *
+ * @param list
+ */
+template <typename T>
+static void list_data_free_(List<T>* list) {
+    assert(list);
+
+    if (list->mapping.kind != ListMapping::NONE)
+        list_mapping_free(&list->mapping);
+    else
+        list_allocator_free(&list->allocator, list_data(list), list_data_size<T>((size_t)list->capacity));
 
-    list->arr = (ListNode*)calloc(init_capacity, sizeof(ListNode));
+    list_data_assign<T>(list, nullptr, 0);
+}
+
+// Free list is doubly linked. Free slot keeps (-1 - previous free slot index) in prev,
+// so prev of free_head is -1 and every free slot has negative prev.
+// Slots over free_watermark aren't linked: they are taken in ascending order, when free list is empty
+
+/**
+ * @brief Pushes slot to the front of free list and poisons it
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+static inline void list_free_push_(List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+    assert(phys_i > 0);
+
+    list_node_set(list, phys_i, ListNode<T>::EMPTY_INDEX, ListNode<T>::POISON, list->free_head);
 
-    CHECK_AND_RETURN(list->arr == nullptr, list->ALLOC_ERR);
+    if (list->free_head != 0)
+        list_prev(list, list->free_head) = -1 - phys_i;
 
-    list->capacity = (ssize_t)init_capacity;
-    list->arr[0] = {.prev = 0, .elem = ListNode::POISON, .next = 0};
+    list->free_head = phys_i;
+
+    list_free_map_push(list, phys_i);
+}
+
+/**
+ * @brief Unlinks free slot from free list in O(1)
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+static inline void list_free_remove_(List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+    assert(phys_i < list->free_watermark);
+    assert(list_is_free(list, phys_i));
 
-    for (ssize_t i = 1; i < list->capacity; i++) {
-        list->arr[i].elem = ListNode::POISON;
-        list->arr[i].prev = ListNode::EMPTY_INDEX;
-        list->arr[i].next = i + 1;
+    const list_idx_t prev_free = -1 - list_prev(list, phys_i);
+    const list_idx_t next_free = list_next(list, phys_i);
+
+    if (prev_free == 0)
+        list->free_head = next_free;
+    else
+        list_next(list, prev_free) = next_free;
+
+    if (next_free != 0)
+        list_prev(list, next_free) = -1 - prev_free;
+
+    list_free_map_remove(list, phys_i);
+}
+
+/**
+ * @brief Takes free slot: free list head or the first slot over free_watermark
+ *
+ * @param list
+ * @return list_idx_t
+ */
+template <typename T>
+static list_idx_t list_free_pop_(List<T>* list) {
+    assert(list);
+
+    if (list->free_head != 0) {
+        const list_idx_t phys_i = list->free_head;
+
+        list_free_remove_(list, phys_i);
+        return phys_i;
     }
 
-    list->arr[list->capacity - 1].next = 0;
+    assert(list->free_watermark < list->capacity);
 
-    list->free_head = 1;
+    return list->free_watermark++;
+}
+
+/**
+ * @brief Takes given free slot. Slot over free_watermark is taken after slots under it are linked
+ *        into free list, so it is O(1) only for slots under free_watermark and for free_watermark itself
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+static void list_free_take_(List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+    assert(phys_i > 0 && list_is_free(list, phys_i));
+
+    if (phys_i < list->free_watermark) {
+        list_free_remove_(list, phys_i);
+        return;
+    }
+
+    while (list->free_watermark < phys_i)
+        list_free_push_(list, list->free_watermark++);
+
+    list->free_watermark++;
+}
+
+/**
+ * @brief Makes slots [first, capacity) free in O(1) (O(free_watermark / 64) with free map).
+ *        They are taken in ascending order
+ *
+ * @attention Slots [1, first) must be occupied
+ *
+ * @param list
+ * @param first
+ */
+template <typename T>
+static void list_free_reset_(List<T>* list, const list_idx_t first) {
+    assert(list);
+    assert(first < list->capacity);
+
+    // map has set bits only if free list isn't empty
+    if (list->free_head != 0)
+        list_free_map_clear(list);
+
+    list->free_head      = 0;
+    list->free_watermark = first;
+}
+
+template <typename T>
+int list_ctor(List<T>* list, size_t init_capacity) {
+    assert(list);
+
+    int res = list->OK;
+
+    CHECK_AND_RETURN(list_is_initialised(list), list->ALREADY_INITIALISED);
+
+    CHECK_AND_RETURN(init_capacity >= (size_t)LIST_IDX_MAX, list->INVALID_CAPACITY);
+
+    init_capacity++; //< fake element
+
+    CHECK_AND_RETURN(!list_data_alloc_(list, init_capacity), list->ALLOC_ERR);
+
+    list->capacity = (list_idx_t)init_capacity;
+    list_node_set(list, 0, 0, ListNode<T>::POISON, 0);
+
+    list_free_reset_(list, 1);
 
     list->size = 0;
     list->is_linear = true;
+    list->linear_prefix = 0;
+    list->linear_offset = 0;
 
     return res | LIST_ASSERT(list);
 }
 
-int list_dtor(List* list) {
+template <typename T>
+int list_dtor(List<T>* list) {
     int res = LIST_VERIFY(list);
     LIST_OK(list, res);
 
-    fill(list->arr, (size_t)list->capacity, &POISON_LIST_NODE, sizeof(POISON_LIST_NODE));
+    if (list->mapping.kind != ListMapping::NONE)
+        res |= list_sync(list);
+
+#ifndef NDEBUG
+    // freed data is poisoned to catch use after destruction. Slots over free_watermark were never
+    // touched, so they are skipped. Mapped data isn't poisoned, because it would be written to file
+    if (list->mapping.kind == ListMapping::NONE) {
+        const list_idx_t used_end = MIN(MAX(list->free_watermark, 0), list->capacity);
+
+        for (list_idx_t i = 0; i < used_end; i++)
+            list_node_set(list, i, ListNode<T>::EMPTY_INDEX, ListNode<T>::POISON, ListNode<T>::EMPTY_INDEX);
+    }
+#endif //< #ifndef NDEBUG
 
-    FREE(list->arr);
+    list_data_free_(list);
+
+    list_order_index_disable(list);
+    list_value_index_disable(list);
+    list_free_map_disable(list);
 
     list->capacity  = list->UNITIALISED_VAL;
     list->free_head = list->UNITIALISED_VAL;
     list->size      = list->UNITIALISED_VAL;
     list->is_linear = false;
+    list->linear_prefix  = list->UNITIALISED_VAL;
+    list->linear_offset  = 0;
+    list->free_watermark = list->UNITIALISED_VAL;
+
+    return res;
+}
+
+/**
+ * @brief Reallocates list data block keeping nodes on their physical indexes
+ *
+ * @param list
+ * @param new_capacity
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_data_realloc_(List<T>* list, const list_idx_t new_capacity) {
+    assert(list);
+
+    const size_t old_cap = (size_t)list->capacity;
+    const size_t new_cap = (size_t)new_capacity;
+
+    void* data = list_data(list);
+
+#ifdef LIST_SOA
+    // move arrays down before the block is cut
+    if (new_cap < old_cap) {
+        memmove((list_idx_t*)data + new_cap, list->prev, new_cap * sizeof(list_idx_t));
+        memmove((char*)data + list_data_elem_offset<T>(new_cap), list->elem, new_cap * sizeof(T));
+    }
+#endif //< #ifdef LIST_SOA
+
+    const size_t old_size = list_data_size<T>(old_cap);
+    const size_t new_size = list_data_size<T>(new_cap);
+
+    void* new_data = nullptr;
+
+    // new slots are over free_watermark, so they aren't zeroed and their pages aren't touched
+    switch (list->mapping.kind) {
+        case ListMapping::NONE:
+            new_data = list_allocator_realloc(&list->allocator, data, old_size, new_size);
+            break;
+
+        case ListMapping::FILE_PRIVATE:
+            // private mapping can't grow over the end of file, so data is moved to allocator block
+            new_data = list_allocator_alloc(&list->allocator, new_size);
+
+            if (new_data != nullptr) {
+                memcpy(new_data, data, MIN(old_size, new_size));
+                list_mapping_free(&list->mapping);
+            }
+            break;
+
+        case ListMapping::ANON:
+        case ListMapping::FILE_SHARED:
+            new_data = list_mapping_realloc(&list->mapping, data, old_size, new_size);
+            break;
+
+        default:
+            assert(0 && "Invalid mapping kind");
+            break;
+    }
+
+    if (new_data == nullptr) {
+        if (new_cap > old_cap)
+            return false;
+
+        new_data = data; //< old block is big enough
+    }
+
+#ifdef LIST_SOA
+    // move arrays up after the block is enlarged. elem first, because it is the highest
+    if (new_cap > old_cap) {
+        memmove((char*)new_data + list_data_elem_offset<T>(new_cap),
+                (char*)new_data + list_data_elem_offset<T>(old_cap), old_cap * sizeof(T));
+        memmove((list_idx_t*)new_data + new_cap, (list_idx_t*)new_data + old_cap,
+                old_cap * sizeof(list_idx_t));
+    }
+#endif //< #ifdef LIST_SOA
+
+    list_data_assign(list, new_data, new_cap);
+    return true;
+}
+
+/**
+ * @brief Reverses elements in slots [first, last]. Links aren't changed
+ *
+ * @param list
+ * @param first
+ * @param last
+ */
+template <typename T>
+static void list_elems_reverse_(List<T>* list, list_idx_t first, list_idx_t last) {
+    assert(list);
+
+    for (; first < last; first++, last--) {
+        const T elem = list_elem(list, first);
+
+        list_elem(list, first) = list_elem(list, last);
+        list_elem(list, last)  = elem;
+    }
+}
+
+/**
+ * @brief Rotates circular linear window of linear list to slots [1, size] in O(capacity)
+ *
+ * @param list
+ */
+template <typename T>
+static void list_rotate_(List<T>* list) {
+    assert(list);
+    assert(list->is_linear);
+
+    if (list->linear_offset == 0)
+        return;
+
+    // window and free slots before it are rotated by three reversals. If window is wrapped,
+    // the last slot is occupied, so all rotated slots are under free_watermark
+    const list_idx_t end = MIN(list->linear_offset + list->size, list->capacity - 1);
+
+    list_elems_reverse_(list, 1, list->linear_offset);
+    list_elems_reverse_(list, list->linear_offset + 1, end);
+    list_elems_reverse_(list, 1, end);
+
+    for (list_idx_t phys_i = 1; phys_i <= list->size; phys_i++)
+        list_node_set(list, phys_i, phys_i - 1, list_elem(list, phys_i), phys_i < list->size ? phys_i + 1 : 0);
+
+    list_next(list, 0) = list->size > 0 ? 1 : 0;
+    list_prev(list, 0) = list->size;
+
+    list_free_reset_(list, list->size + 1);
+
+    list->linear_offset = 0;
+
+    list_order_index_invalidate(list);
+    list_value_index_invalidate(list);
+}
+
+/**
+ * @brief Enlarges capacity. Physical indexes of elements are kept
+ *
+ * @param list
+ * @param new_capacity
+ * @return int
+ */
+template <typename T>
+static int list_resize_grow_(List<T>* list, const list_idx_t new_capacity) {
+    assert(list);
+    assert(new_capacity > list->capacity);
+
+    int res = list->OK;
+
+    const list_idx_t old_capacity = list->capacity;
+    const list_idx_t wrapped = list->linear_offset + list->linear_prefix - (old_capacity - 1);
+
+    // wrapped window would be broken by new capacity, so prefix is cut to its unwrapped part.
+    // Elements aren't moved: resize keeps physical indexes
+    if (wrapped > 0) {
+        list->linear_prefix = old_capacity - 1 - list->linear_offset;
+        list->is_linear = false;
+    }
+
+    CHECK_AND_RETURN(!list_data_realloc_(list, new_capacity), list->ALLOC_ERR);
+
+    list->capacity = new_capacity;
+    list_order_index_invalidate(list);
+    list_free_map_invalidate(list);
+
+    // new slots are over free_watermark already. Free slots of linear list are [size + 1, capacity),
+    // so they are taken in ascending order by pushback
+    if (list->is_linear && list->linear_offset == 0)
+        list_free_reset_(list, list->size + 1);
+
+    return res;
+}
+
+/**
+ * @brief Cuts free tail of array. Capacity won't be less than (the last occupied index + 1).
+ *        Physical indexes of elements are kept
+ *
+ * @param list
+ * @param new_capacity
+ * @return int
+ */
+template <typename T>
+static int list_resize_shrink_(List<T>* list, list_idx_t new_capacity) {
+    assert(list);
+    assert(new_capacity < list->capacity);
+
+    int res = list->OK;
+
+    new_capacity = MAX(new_capacity, list->size + 1 + 1);
+
+    // occupied slots aren't cut, so window, that doesn't fit new capacity, keeps capacity
+    list_idx_t last_used = list->free_watermark - 1;
+    while (last_used >= new_capacity && list_is_free(list, last_used))
+        last_used--;
+
+    new_capacity = MAX(new_capacity, last_used + 1);
+
+    if (new_capacity >= list->capacity)
+        return res;
+
+    if (list->is_linear && list->linear_offset == 0) {
+        list_free_reset_(list, list->size + 1);
+    } else {
+        for (list_idx_t phys_i = new_capacity; phys_i < list->free_watermark; phys_i++)
+            list_free_remove_(list, phys_i);
+
+        list->free_watermark = MIN(list->free_watermark, new_capacity);
+    }
+
+    CHECK_AND_RETURN(!list_data_realloc_(list, new_capacity), list->ALLOC_ERR);
+
+    list->capacity = new_capacity;
+    list_order_index_invalidate(list);
 
     return res;
 }
 
-int list_resize(List* list, size_t new_capacity) {
+template <typename T>
+int list_resize(List<T>* list, size_t new_capacity) {
     int res = LIST_ASSERT(list);
-    assert((ssize_t)new_capacity != list->capacity);
+    assert((list_idx_t)new_capacity != list->capacity);
+
+    CHECK_AND_RETURN(new_capacity > (size_t)LIST_IDX_MAX, list->CAPACITY_OVERFLOW);
 
-    res |= list_linearise(list, (ssize_t)new_capacity);
+    if ((list_idx_t)new_capacity > list->capacity)
+        res |= list_resize_grow_(list, (list_idx_t)new_capacity);
+    else
+        res |= list_resize_shrink_(list, (list_idx_t)new_capacity);
 
     if (res != list->OK)
         return res;
@@ -74,66 +476,204 @@ int list_resize(List* list, size_t new_capacity) {
     return res | LIST_ASSERT(list);
 }
 
-int list_linearise(List* list, ssize_t new_capacity) {
+template <typename T>
+int list_reserve(List<T>* list, const size_t n) {
+    int res = LIST_ASSERT(list);
+
+    CHECK_AND_RETURN(n >= (size_t)LIST_IDX_MAX - 1 - 1, list->CAPACITY_OVERFLOW);
+
+    // list_resize_up keeps one slot free after insert
+    const list_idx_t new_capacity = (list_idx_t)n + 1 + 1;
+
+    if (new_capacity > list->capacity)
+        res |= list_resize(list, (size_t)new_capacity);
+
+    return res;
+}
+
+template <typename T>
+int list_shrink_to_fit(List<T>* list) {
+    int res = LIST_ASSERT(list);
+
+    const list_idx_t new_capacity = MAX(list->size + 1 + 1, list->resize_policy.min_capacity + 1);
+
+    if (new_capacity < list->capacity)
+        res |= list_linearise(list, new_capacity);
+
+    return res;
+}
+
+/**
+ * @brief Swaps two slots and fixes links of their neighbours. Free list links are not fixed
+ *
+ * @param list
+ * @param a
+ * @param b
+ */
+template <typename T>
+static void list_node_swap_(List<T>* list, const list_idx_t a, const list_idx_t b) {
+    assert(list);
+    assert(a > 0 && b > 0);
+
+    const list_idx_t prev_a = list_prev(list, a);
+    const list_idx_t next_a = list_next(list, a);
+    const T          elem_a = list_elem(list, a);
+
+    list_node_set(list, a, list_prev(list, b), list_elem(list, b), list_next(list, b));
+    list_node_set(list, b, prev_a, elem_a, next_a);
+
+    // nodes could be neighbours, so their own links are remapped before neighbours are fixed
+    #define REMAP_(idx_) if (idx_ == a) idx_ = b; else if (idx_ == b) idx_ = a
+
+    const list_idx_t slots[] = {a, b};
+
+    for (list_idx_t phys_i : slots) {
+        if (list_is_free(list, phys_i))
+            continue;
+
+        REMAP_(list_prev(list, phys_i));
+        REMAP_(list_next(list, phys_i));
+    }
+
+    #undef REMAP_
+
+    list_order_index_swap(list, a, b);
+    list_value_index_swap(list, a, b);
+
+    for (list_idx_t phys_i : slots) {
+        if (list_is_free(list, phys_i))
+            continue;
+
+        list_next(list, list_prev(list, phys_i)) = phys_i;
+        list_prev(list, list_next(list, phys_i)) = phys_i;
+    }
+}
+
+template <typename T>
+int list_linearise(List<T>* list, list_idx_t new_capacity) {
     int res = LIST_ASSERT(list);
 
     if (new_capacity == -1) {
         new_capacity = list->capacity;
     }
 
-    ListNode* new_arr = (ListNode*)calloc((size_t)new_capacity, sizeof(ListNode));
+    if (list->is_linear) {
+        // circular window is only rotated
+        list_rotate_(list);
+    } else {
+        list_order_index_invalidate(list);
+        list_value_index_invalidate(list);
 
-    CHECK_AND_RETURN(new_arr == nullptr, list->ALLOC_ERR);
+        // k-th element is swapped to k-th slot, so array is permuted in place. Linear prefix is skipped,
+        // if it is stored from the first slot
+        const list_idx_t first_log = list->linear_offset == 0 ? list->linear_prefix : 0;
 
-    new_arr[0] = {.prev = 0, .elem = ListNode::POISON, .next = 0};
+        list_idx_t phys_i = list_next(list, first_log);
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
+        for (list_idx_t log_i = first_log + 1; log_i <= list->size; log_i++) {
+            CHECK_AND_RETURN(phys_i <= 0 || phys_i >= list->capacity, list->DAMAGED_PATH);
 
-    LIST_FOREACH(*list, phys_i, log_i) {
-        new_arr[log_i].next = log_i + 1;
+            if (phys_i != log_i)
+                list_node_swap_(list, phys_i, log_i);
 
-        new_arr[log_i + 1] = {.prev = log_i, .elem = list->arr[phys_i].elem, .next = 0};
+            phys_i = list_next(list, log_i);
+        }
+
+        list_free_reset_(list, list->size + 1);
+
+        list->linear_prefix = list->size;
+        list->linear_offset = 0;
+        list->is_linear = true;
     }
 
-    LIST_IS_FOREACH_VALID(*list, log_i, {
-        res |= list->DAMAGED_PATH;
-        LIST_OK(list, res);
+    if (new_capacity > list->capacity)
+        res |= list_resize_grow_(list, new_capacity);
+    else if (new_capacity < list->capacity)
+        res |= list_resize_shrink_(list, new_capacity);
+
+    if (res != list->OK)
         return res;
-    });
 
-    new_arr[0].prev = log_i;
+    return res | LIST_ASSERT(list);
+}
+
+/**
+ * @brief Moves at most moves elements to their linear positions, extending linear prefix
+ *
+ * @param list
+ * @param moves
+ * @param tracked_i physical index, that is updated if its element is moved (may be nullptr)
+ */
+template <typename T>
+static void list_compact_(List<T>* list, list_idx_t moves, list_idx_t* tracked_i) {
+    assert(list);
 
+    while (moves-- > 0 && list->linear_prefix < list->size) {
+        const list_idx_t slot   = list_linear_phys(list, list->linear_prefix);
+        const list_idx_t phys_i = list_next(list, list->linear_prefix > 0 ?
+                                                  list_linear_phys(list, list->linear_prefix - 1) : 0);
 
-    list->free_head = log_i + 1;
+        if (phys_i != slot) {
+            if (list_is_free(list, slot)) {
+                // window is occupied, so slot after it is free_watermark at most
+                list_free_take_(list, slot);
 
-    for (phys_i = list->free_head; phys_i < (ssize_t)new_capacity; phys_i++)
-        new_arr[phys_i] = {.prev = list->UNITIALISED_VAL, .elem = ListNode::POISON,
-                           .next = phys_i + 1};
+                list_node_set(list, slot, list_prev(list, phys_i), list_elem(list, phys_i),
+                                          list_next(list, phys_i));
 
-    new_arr[phys_i - 1].next = 0;
+                list_next(list, list_prev(list, slot)) = slot;
+                list_prev(list, list_next(list, slot)) = slot;
 
-    FREE(list->arr);
-    list->arr = new_arr;
-    list->capacity = new_capacity;
-    list->is_linear = true;
+                list_free_push_(list, phys_i);
+
+                list_order_index_swap(list, phys_i, slot);
+                list_value_index_swap(list, phys_i, slot);
+            } else {
+                list_node_swap_(list, phys_i, slot);
+            }
+
+            if (tracked_i != nullptr) {
+                if (*tracked_i == phys_i)
+                    *tracked_i = slot;
+                else if (*tracked_i == slot)
+                    *tracked_i = phys_i;
+            }
+        }
+
+        list->linear_prefix++;
+    }
+
+    list->is_linear = list->linear_prefix == list->size;
+}
+
+template <typename T>
+int list_compact_step(List<T>* list, const list_idx_t moves) {
+    int res = LIST_ASSERT(list);
+
+    CHECK_AND_RETURN(moves < 0, list->INVALID_POSITION);
+
+    list_compact_(list, moves, (list_idx_t*)nullptr);
 
     return res | LIST_ASSERT(list);
 }
 
-int list_find_by_logical_index(const List* list, ssize_t logical_i, ssize_t* physical_i) {
+template <typename T>
+int list_find_by_logical_index(const List<T>* list, list_idx_t logical_i, list_idx_t* physical_i) {
     assert(physical_i);
     int res = LIST_ASSERT(list);
 
     CHECK_AND_RETURN(logical_i >= list->size || logical_i < 0, list->INVALID_POSITION, {
                                                                *physical_i = -1;});
-    if (list->is_linear) {
-        *physical_i = logical_i + 1;
+    if (logical_i < list->linear_prefix) {
+        *physical_i = list_linear_phys(list, logical_i);
         return res;
     }
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
+    if (list->order_index != nullptr && list_order_index_find(list, logical_i, physical_i))
+        return res;
+
+    list_idx_t phys_i = list_head(list);
+    list_idx_t log_i = 0;
     LIST_FOREACH(*list, phys_i, log_i) {
         if (logical_i-- == 0) {
             *physical_i = phys_i;
@@ -151,17 +691,114 @@ int list_find_by_logical_index(const List* list, ssize_t logical_i, ssize_t* phy
     return res;
 }
 
-int list_find_by_value(const List* list, const Elem_t elem, ssize_t* physical_i) {
+/**
+ * @brief Returns first physical index from [from, to), which element equals elem. Slots are
+ *        swept in physical order, so there are no dependent loads of next indexes
+ *
+ * @attention Free slots are poisoned, but they still have to be skipped by caller
+ *
+ * @param list
+ * @param elem
+ * @param from
+ * @param to
+ * @return list_idx_t -1 if not found
+ */
+template <typename T>
+static list_idx_t list_scan_(const List<T>* list, const T elem, const list_idx_t from, const list_idx_t to) {
+    assert(list);
+
+#ifdef LIST_SOA
+    return list_scan_find(list->elem, from, to, elem);
+#else //< #ifndef LIST_SOA
+    // elements are strided by node size, so only scalar sweep is possible
+    for (list_idx_t phys_i = from; phys_i < to; phys_i++)
+        if (ListElemTraits<T>::equal(list_elem(list, phys_i), elem))
+            return phys_i;
+
+    return -1;
+#endif //< #ifdef LIST_SOA
+}
+
+/**
+ * @brief Finds first (in logical order) element equal to elem out of linear prefix by physical sweep
+ *
+ * @param list
+ * @param elem
+ * @param physical_i returnable value. -1 if not found
+ * @return true success
+ * @return false there are several hits and order index can't order them
+ */
+template <typename T>
+static bool list_scan_first_(const List<T>* list, const T elem, list_idx_t* physical_i) {
+    assert(list);
+    assert(physical_i);
+
+    list_idx_t hit     = -1;
+    list_idx_t hit_log = -1;
+
+    // linear prefix is skipped, if it is stored from the first slot
+    const list_idx_t from = list->linear_offset == 0 ? list->linear_prefix + 1 : 1;
+
+    for (list_idx_t phys_i = list_scan_(list, elem, from,       list->free_watermark); phys_i != -1;
+                    phys_i = list_scan_(list, elem, phys_i + 1, list->free_watermark)) {
+        if (list_is_free(list, phys_i) || list_linear_log(list, phys_i) < list->linear_prefix)
+            continue;
+
+        if (hit == -1) {
+            hit = phys_i;
+            continue;
+        }
+
+        // several hits are ordered by their logical indexes
+        if (list->order_index == nullptr)
+            return false;
+
+        list_idx_t log_i = -1;
+
+        if ((hit_log == -1 && !list_order_index_logical(list, hit, &hit_log)) ||
+            !list_order_index_logical(list, phys_i, &log_i))
+            return false;
+
+        if (log_i < hit_log) {
+            hit     = phys_i;
+            hit_log = log_i;
+        }
+    }
+
+    *physical_i = hit;
+    return true;
+}
+
+template <typename T>
+int list_find_by_value(const List<T>* list, const T elem, list_idx_t* physical_i) {
     assert(physical_i);
     int res = LIST_ASSERT(list);
 
-    CHECK_AND_RETURN(elem == ListNode::POISON, list->POISON_VAL_FOUND, {
+    CHECK_AND_RETURN(list_is_poison(elem), list->POISON_VAL_FOUND, {
                                                *physical_i = -1;});
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
+    if (list->value_index != nullptr && list_value_index_find(list, elem, physical_i))
+        return res;
+
+    // linear prefix is stored sequentially (it may be wrapped to the first slot), so its first hit
+    // is the first one in logical order
+    const list_idx_t prefix_end = list->linear_offset + list->linear_prefix + 1;
+
+    *physical_i = list_scan_(list, elem, list->linear_offset + 1, MIN(prefix_end, list->capacity));
+
+    if (*physical_i == -1 && prefix_end > list->capacity)
+        *physical_i = list_scan_(list, elem, 1, prefix_end - (list->capacity - 1));
+
+    if (*physical_i != -1 || list->is_linear)
+        return res;
+
+    if (list_scan_first_(list, elem, physical_i))
+        return res;
+
+    list_idx_t phys_i = list_head(list);
+    list_idx_t log_i = 0;
     LIST_FOREACH(*list, phys_i, log_i) {
-        if (list->arr[phys_i].elem == elem) {
+        if (ListElemTraits<T>::equal(list_elem(list, phys_i), elem)) {
             *physical_i = phys_i;
             return res;
         }
@@ -177,19 +814,72 @@ int list_find_by_value(const List* list, const Elem_t elem, ssize_t* physical_i)
     return res;
 }
 
-int list_logical_index_by_physical(const List* list, const ssize_t physical_i, ssize_t* logical_i) {
+template <typename T>
+int list_count_value(const List<T>* list, const T elem, list_idx_t* count) {
+    assert(count);
+    int res = LIST_ASSERT(list);
+
+    CHECK_AND_RETURN(list_is_poison(elem), list->POISON_VAL_FOUND, {
+                                               *count = 0;});
+
+    *count = 0;
+
+    // free tail of linear list and slots over free_watermark are not swept
+    const list_idx_t end = list->is_linear && list->linear_offset == 0 ? list->size + 1 : list->free_watermark;
+
+    for (list_idx_t phys_i = list_scan_(list, elem, 1, end); phys_i != -1;
+                    phys_i = list_scan_(list, elem, phys_i + 1, end)) {
+        if (!list_is_free(list, phys_i))
+            (*count)++;
+    }
+
+    return res;
+}
+
+template <typename T>
+int list_link_locality(const List<T>* list, double* avg_distance) {
+    assert(avg_distance);
+    int res = LIST_ASSERT(list);
+
+    *avg_distance = 0;
+
+    if (list->size < 2)
+        return res;
+
+    double total = 0;
+
+    list_idx_t phys_i = list_head(list);
+
+    for (list_idx_t log_i = 1; log_i < list->size; log_i++) {
+        const list_idx_t next = list_next(list, phys_i);
+
+        total += (double)(next > phys_i ? next - phys_i : phys_i - next);
+
+        phys_i = next;
+    }
+
+    *avg_distance = total / (double)(list->size - 1);
+
+    return res;
+}
+
+template <typename T>
+int list_logical_index_by_physical(const List<T>* list, const list_idx_t physical_i, list_idx_t* logical_i) {
     assert(logical_i);
     int res = LIST_ASSERT(list);
 
     CHECK_AND_RETURN(physical_i >= list->capacity || physical_i <= 0, list->INVALID_POSITION, {
                                                                       *logical_i = -1;});
-    if (list->is_linear) {
-        *logical_i = physical_i - 1;
+    if (list_linear_log(list, physical_i) < list->linear_prefix) {
+        *logical_i = list_linear_log(list, physical_i);
         return res;
     }
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
+    if (list->order_index != nullptr && list_order_index_logical(list, physical_i, logical_i))
+        return res;
+
+    list_idx_t phys_i = list_head(list);
+    list_idx_t log_i = 0;
     LIST_FOREACH(*list, phys_i, log_i) {
         if (physical_i == phys_i) {
             *logical_i = log_i;
@@ -209,7 +899,199 @@ int list_logical_index_by_physical(const List* list, const ssize_t physical_i, s
 
 #define CHECK_ERR_(clause, err) if (clause) res |= err
 
-int list_verify(const List* list) {
+/**
+ * @brief Verifies list fields in O(1)
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+static int list_verify_fields_(const List<T>* list) {
+    assert(list);
+
+    int res = list->OK;
+
+    CHECK_ERR_(list->capacity < list->size + 1, list->LOW_CAPACITY);
+    CHECK_ERR_(list->capacity < 0, list->NEGATIVE_CAPACITY);
+    CHECK_ERR_(list->size < 0, list->NEGATIVE_SIZE);
+    CHECK_ERR_(list->free_watermark <= 0 || list->free_watermark > list->capacity, list->INVALID_FREE_HEAD);
+    CHECK_ERR_(list->free_head < 0 || list->free_head >= MAX(list->free_watermark, 1), list->INVALID_FREE_HEAD);
+    CHECK_ERR_(list->free_head == 0 && list->free_watermark == list->capacity, list->INVALID_FREE_HEAD);
+    CHECK_ERR_(list->linear_prefix < 0 || list->linear_prefix > list->size, list->INVALID_IS_LINEAR);
+    CHECK_ERR_(list->is_linear != (list->linear_prefix == list->size), list->INVALID_IS_LINEAR);
+    CHECK_ERR_(list->linear_offset < 0 || list->linear_offset >= MAX(list->capacity - 1, 1), list->INVALID_IS_LINEAR);
+    CHECK_ERR_(!(list->resize_policy.growth_factor > 1) || !(list->resize_policy.shrink_load >= 0) ||
+               list->resize_policy.shrink_load * list->resize_policy.growth_factor >= 1 ||
+               list->resize_policy.min_capacity < 0 || list->resize_policy.min_capacity >= LIST_IDX_MAX,
+               list->INVALID_RESIZE_POLICY);
+
+    return res;
+}
+
+/**
+ * @brief Verifies one node and its links in O(1)
+ *
+ * @param list
+ * @param phys_i
+ * @return int
+ */
+template <typename T>
+static int list_verify_node_(const List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+
+    int res = list->OK;
+
+    // errors are printed by caller, so CHECK_AND_RETURN isn't used
+    if (phys_i < 0 || phys_i >= list->capacity)
+        return list->INVALID_POSITION;
+
+    // slot over free_watermark isn't initialised
+    if (phys_i >= list->free_watermark)
+        return res;
+
+    const list_idx_t next = list_next(list, phys_i);
+
+    if (list_is_free(list, phys_i)) {
+        const list_idx_t prev_free = -1 - list_prev(list, phys_i);
+
+        CHECK_ERR_(!list_is_poison(list_elem(list, phys_i)), list->NON_POISON_EMPTY);
+
+        if (next < 0 || next >= list->free_watermark || prev_free >= list->free_watermark)
+            return res | list->DAMAGED_FREE_LIST;
+
+        CHECK_ERR_(next != 0 && list_prev(list, next) != -1 - phys_i, list->DAMAGED_FREE_LIST);
+        CHECK_ERR_(prev_free == 0 && list->free_head != phys_i, list->DAMAGED_FREE_LIST);
+        CHECK_ERR_(prev_free >  0 && list_next(list, prev_free) != phys_i, list->DAMAGED_FREE_LIST);
+
+        return res;
+    }
+
+    const list_idx_t prev = list_prev(list, phys_i);
+
+    // elements are never stored over free_watermark
+    if (next < 0 || next >= list->free_watermark || prev >= list->free_watermark)
+        return res | list->DAMAGED_PATH;
+
+    CHECK_ERR_(phys_i != 0 && list_is_poison(list_elem(list, phys_i)), list->POISON_VAL_FOUND);
+    CHECK_ERR_(list_prev(list, next) != phys_i || list_next(list, prev) != phys_i, list->DAMAGED_PATH);
+
+    // linear prefix elements are stored sequentially
+    const list_idx_t log_i = list_linear_log(list, phys_i);
+
+    CHECK_ERR_(phys_i > 0 && log_i < list->linear_prefix &&
+               prev != (log_i > 0 ? list_linear_phys(list, log_i - 1) : 0), list->INVALID_IS_LINEAR);
+
+    return res;
+}
+
+template <typename T>
+int list_verify_nodes(const List<T>* list, const list_idx_t a, const list_idx_t b) {
+    assert(list);
+
+    int res = list->OK;
+
+    CHECK_AND_RETURN(!list_is_initialised(list), list->UNITIALISED);
+
+    res |= list_verify_fields_(list);
+
+    if (res != list->OK)
+        return res;
+
+    res |= list_verify_node_(list, 0);
+    res |= list_verify_node_(list, list->free_head);
+
+    const list_idx_t nodes[] = {a, b};
+
+    for (list_idx_t phys_i : nodes) {
+        res |= list_verify_node_(list, phys_i);
+
+        if (res != list->OK || list_is_free(list, phys_i))
+            continue;
+
+        res |= list_verify_node_(list, list_prev(list, phys_i));
+        res |= list_verify_node_(list, list_next(list, phys_i));
+    }
+
+    return res;
+}
+
+/**
+ * @brief Full verification sampling settings
+ */
+struct ListVerifySampling {
+    list_idx_t every_ops = LIST_VERIFY_EVERY_OPS;  //< full verification on every Nth check (0 - never)
+    double     every_ms  = LIST_VERIFY_EVERY_MS;   //< full verification once in N ms (0 - never)
+
+    list_idx_t checks_num = 0;                      //< checks since last full verification
+    double     last_full_ms = 0;                    //< time of last full verification
+};
+
+static ListVerifySampling list_verify_sampling = {};
+
+/**
+ * @brief Returns monotonic time in ms
+ *
+ * @return double
+ */
+static double list_verify_time_ms_() {
+    timespec time = {};
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double)time.tv_sec * 1e3 + (double)time.tv_nsec * 1e-6;
+}
+
+/**
+ * @brief Returns true if full verification has to be done now
+ *
+ * @return true
+ * @return false
+ */
+static bool list_verify_is_full_due_() {
+    ListVerifySampling* sampling = &list_verify_sampling;
+
+    bool is_due = false;
+
+    if (sampling->every_ops > 0 && ++sampling->checks_num >= sampling->every_ops)
+        is_due = true;
+
+    if (sampling->every_ms > 0) {
+        const double now = list_verify_time_ms_();
+
+        if (now - sampling->last_full_ms >= sampling->every_ms)
+            is_due = true;
+
+        if (is_due)
+            sampling->last_full_ms = now;
+    }
+
+    if (is_due)
+        sampling->checks_num = 0;
+
+    return is_due;
+}
+
+void list_verify_set_sampling(const list_idx_t every_ops, const double every_ms) {
+    list_verify_sampling.every_ops  = every_ops;
+    list_verify_sampling.every_ms   = every_ms;
+    list_verify_sampling.checks_num = 0;
+}
+
+template <typename T>
+int list_verify_sampled(const List<T>* list) {
+    assert(list);
+
+    if (list_verify_is_full_due_())
+        return list_verify(list);
+
+    int res = list->OK;
+
+    CHECK_AND_RETURN(!list_is_initialised(list), list->UNITIALISED);
+
+    return list_verify_fields_(list);
+}
+
+template <typename T>
+int list_verify(const List<T>* list) {
     assert(list);
 
     int res = list->OK;
@@ -218,15 +1100,12 @@ int list_verify(const List* list) {
 
     bool is_data_valid = true;
 
-    if (!is_ptr_valid(list->arr)) {
+    if (!is_ptr_valid(list_data(list))) {
         res |= list->DATA_INVALID_PTR;
         is_data_valid = false;
     }
 
-    CHECK_ERR_(list->capacity < list->size + 1, list->LOW_CAPACITY);
-    CHECK_ERR_(list->capacity < 0, list->NEGATIVE_CAPACITY);
-    CHECK_ERR_(list->size < 0, list->NEGATIVE_SIZE);
-    CHECK_ERR_(list->free_head <= 0, list->INVALID_FREE_HEAD);
+    res |= list_verify_fields_(list);
 
     if (!is_data_valid)
         return res;
@@ -234,15 +1113,24 @@ int list_verify(const List* list) {
     CHECK_ERR_(list_tail(list) < 0, list->INVALID_TAIL);
     CHECK_ERR_(list_head(list) < 0, list->INVALID_HEAD);
 
-    ssize_t prev_phys_i = 0;
+    // free_watermark could be damaged too, so it is clamped to array
+    const list_idx_t used_end = MIN(MAX(list->free_watermark, 1), list->capacity);
+
+    list_idx_t prev_phys_i = 0;
 
-    ssize_t phys_i = list_head(list);
-    ssize_t log_i = 0;
+    list_idx_t phys_i = list_head(list);
+    list_idx_t log_i = 0;
     LIST_FOREACH(*list, phys_i, log_i) {
-        CHECK_ERR_(list->arr[phys_i].elem == ListNode::POISON, list->POISON_VAL_FOUND);
-        CHECK_ERR_(list->arr[phys_i].prev != prev_phys_i, list->DAMAGED_PATH);
+        // damaged link can point out of initialised part of array (list could be loaded from file)
+        if (phys_i >= used_end) {
+            res |= list->DAMAGED_PATH;
+            break;
+        }
+
+        CHECK_ERR_(list_is_poison(list_elem(list, phys_i)), list->POISON_VAL_FOUND);
+        CHECK_ERR_(list_prev(list, phys_i) != prev_phys_i, list->DAMAGED_PATH);
 
-        CHECK_ERR_(list->is_linear && phys_i != log_i + 1, list->INVALID_IS_LINEAR);
+        CHECK_ERR_(log_i < list->linear_prefix && phys_i != list_linear_phys(list, log_i), list->INVALID_IS_LINEAR);
 
         prev_phys_i = phys_i;
     }
@@ -250,49 +1138,338 @@ int list_verify(const List* list) {
     CHECK_ERR_(log_i != list->size, list->DAMAGED_PATH);
     CHECK_ERR_(phys_i < 0, list->DAMAGED_PATH);
 
-    for (phys_i = 1; phys_i < list->capacity; phys_i++) {
-        CHECK_ERR_(list->arr[phys_i].prev != -1 && list->arr[phys_i].elem == ListNode::POISON,
-                                                                        list->POISON_VAL_FOUND);
-        CHECK_ERR_(list->arr[phys_i].prev == -1 && list->arr[phys_i].elem != ListNode::POISON,
-                                                                        list->NON_POISON_EMPTY);
+    // slots over free_watermark aren't initialised, so they aren't checked
+    list_idx_t free_num = 0;
+
+    for (phys_i = 1; phys_i < used_end; phys_i++) {
+        const bool is_free = list_is_free(list, phys_i);
+
+        CHECK_ERR_(!is_free &&  list_is_poison(list_elem(list, phys_i)), list->POISON_VAL_FOUND);
+        CHECK_ERR_( is_free && !list_is_poison(list_elem(list, phys_i)), list->NON_POISON_EMPTY);
+
+        if (is_free) {
+            const list_idx_t prev_free = -1 - list_prev(list, phys_i);
+
+            CHECK_ERR_(prev_free >= used_end, list->DAMAGED_FREE_LIST);
+            CHECK_ERR_(prev_free == 0 && list->free_head != phys_i, list->DAMAGED_FREE_LIST);
+            CHECK_ERR_(prev_free >  0 && prev_free < used_end &&
+                       list_next(list, prev_free) != phys_i, list->DAMAGED_FREE_LIST);
+
+            free_num++;
+        }
     }
 
+    // every free slot under free_watermark is in free list
+    CHECK_ERR_(free_num != used_end - 1 - list->size, list->DAMAGED_FREE_LIST);
+
     return res;
 }
 #undef CHECK_ERR_
 
-int list_insert_after(List* list, const size_t position, const Elem_t elem, size_t* inserted_index) {
+/**
+ * @brief Returns free slot, that keeps element inserted after position in linear window:
+ *        slot after linear prefix or slot before head
+ *
+ * @param list
+ * @param pos_log list_linear_log of position
+ * @return list_idx_t 0 if there isn't such slot
+ */
+template <typename T>
+static inline list_idx_t list_linear_slot_(const List<T>* list, const list_idx_t pos_log) {
+    assert(list);
+
+    if (list->linear_prefix == 0)
+        return 0;
+
+    list_idx_t slot = 0;
+
+    if (pos_log == list->linear_prefix - 1)
+        slot = list_linear_phys(list, list->linear_prefix);
+    else if (pos_log == -1)
+        slot = list_linear_phys(list, list->capacity - 2);
+    else
+        return 0;
+
+    // slots between free_watermark and slot are linked into free list. Initialised part of array is at most
+    // doubled by it, so pages of big reserved capacity aren't touched by one pushfront
+    if (!list_is_free(list, slot) || slot - list->free_watermark > list->free_watermark)
+        return 0;
+
+    return slot;
+}
+
+/**
+ * @brief Updates linear prefix after element inserted_i was linked after position and size was increased
+ *
+ * @param list
+ * @param pos_log list_linear_log of position
+ * @param inserted_i
+ */
+template <typename T>
+static inline void list_linear_insert_(List<T>* list, const list_idx_t pos_log, const list_idx_t inserted_i) {
+    assert(list);
+
+    if (pos_log == -1) {
+        // new head starts linear window. Window is kept, if head is stored right before it
+        const bool is_kept = list->linear_prefix > 0 &&
+                             inserted_i == list_linear_phys(list, list->capacity - 2);
+
+        list->linear_prefix = is_kept ? list->linear_prefix + 1 : 1;
+        list->linear_offset = inserted_i - 1;
+    } else if (pos_log < list->linear_prefix) {
+        // elements after position are shifted
+        list->linear_prefix = pos_log + 1 + (inserted_i == list_linear_phys(list, pos_log + 1) ? 1 : 0);
+    }
+
+    list->is_linear = list->linear_prefix == list->size;
+}
+
+/**
+ * @brief Updates linear prefix after num elements from first were unlinked and size was decreased
+ *
+ * @param list
+ * @param first
+ * @param num
+ */
+template <typename T>
+static inline void list_linear_delete_(List<T>* list, const list_idx_t first, const list_idx_t num) {
+    assert(list);
+
+    const list_idx_t first_log = list_linear_log(list, first);
+
+    if (first_log == 0 && num <= list->linear_prefix) {
+        // head elements are deleted, the rest of window stays in place
+        list->linear_offset = list_linear_phys(list, num) - 1;
+        list->linear_prefix -= num;
+    } else if (first_log < list->linear_prefix) {
+        list->linear_prefix = first_log;
+    }
+
+    if (list->linear_prefix == 0)
+        list->linear_offset = 0;
+
+    list->is_linear = list->linear_prefix == list->size;
+}
+
+template <typename T>
+int list_insert_after(List<T>* list, const list_idx_t position, const T elem, list_idx_t* inserted_index) {
     int res = LIST_ASSERT(list);
 
-    CHECK_AND_RETURN(list->arr[position].prev == -1, list->INVALID_POSITION);
+    CHECK_AND_RETURN(list_is_free(list, position), list->INVALID_POSITION);
 
     res |= list_resize_up(list);
     if (res != list->OK)
         return res;
 
-    *inserted_index = (size_t)list->free_head;
-    list->free_head = list->arr[*inserted_index].next;
+    const list_idx_t pos_log = list_linear_log(list, position);
+
+    *inserted_index = list_linear_slot_(list, pos_log);
+
+    if (*inserted_index == 0)
+        *inserted_index = list_free_map_nearest(list, position);
 
-    list->arr[*inserted_index].prev = (ssize_t)position;
-    list->arr[*inserted_index].next = list->arr[position].next;
+    if (*inserted_index != 0)
+        list_free_take_(list, *inserted_index);
+    else
+        *inserted_index = list_free_pop_(list);
 
-    list->arr[list->arr[position].next].prev = (ssize_t)*inserted_index;
-    list->arr[position].next = (ssize_t)*inserted_index;
+    list_prev(list, *inserted_index) = position;
+    list_next(list, *inserted_index) = list_next(list, position);
 
-    list->arr[*inserted_index].elem = elem;
+    list_prev(list, list_next(list, position)) = *inserted_index;
+    list_next(list, position) = *inserted_index;
+
+    list_elem(list, *inserted_index) = elem;
 
     list->size++;
 
-    if ((ssize_t)*inserted_index != list_tail(list) && (ssize_t)*inserted_index != list_head(list))
-        list->is_linear = false;
+    list_order_index_insert(list, position, *inserted_index);
+    list_value_index_insert(list, *inserted_index);
+
+    list_linear_insert_(list, pos_log, *inserted_index);
+
+    res |= LIST_ASSERT_NODES(list, position, *inserted_index);
+
+    list_compact_(list, list->auto_compact_moves, inserted_index);
 
     return res | LIST_ASSERT(list);
 }
 
-int list_delete(List* list, const size_t position, const bool no_resize) {
+/**
+ * @brief Inserts n elements after position with one resize. Elements are taken from elems array or,
+ *        if it is nullptr, from nodes [src_first, src_last] of another list
+ *
+ * @param list
+ * @param position valid physical index
+ * @param elems
+ * @param src
+ * @param src_first
+ * @param src_last
+ * @param n positive number of elements
+ * @param first_index returns physical index of the first inserted element
+ * @return int
+ */
+template <typename T>
+static int list_insert_range_(List<T>* list, const list_idx_t position, const T* elems, const List<T>* src,
+                              const list_idx_t src_first, const list_idx_t src_last, const list_idx_t n,
+                              list_idx_t* first_index) {
+    assert(list);
+    assert(n > 0);
+    assert(elems != nullptr || (src != nullptr && src != list));
+
+    int res = list_resize_up(list, n);
+    if (res != list->OK)
+        return res;
+
+    // slots after tail of linear list are consecutive, so range appended to it stays linear
+    if (list->is_linear && list->linear_offset == 0 && position == list_tail(list))
+        list_free_reset_(list, list->size + 1);
+
+    // range is inserted before head from its last element, so every element can be stored right before
+    // linear window
+    const bool is_reversed = position == 0 && list->linear_prefix > 0;
+
+    list_idx_t src_i = is_reversed ? src_last : src_first;
+
+    list_idx_t prev = position;
+    list_idx_t phys_i = 0;
+
+    for (list_idx_t i = 0; i < n; i++) {
+        const list_idx_t prev_log = list_linear_log(list, prev);
+
+        phys_i = list_linear_slot_(list, prev_log);
+
+        if (phys_i == 0)
+            phys_i = list_free_map_nearest(list, prev);
+
+        // consecutive slots over free_watermark are preferred to scattered free list slots
+        if (phys_i != 0)
+            list_free_take_(list, phys_i);
+        else if (list->capacity - list->free_watermark >= n - i)
+            phys_i = list->free_watermark++;
+        else
+            phys_i = list_free_pop_(list);
+
+        const list_idx_t next = list_next(list, prev);
+
+        if (elems != nullptr) {
+            list_node_set(list, phys_i, prev, elems[is_reversed ? n - 1 - i : i], next);
+        } else {
+            list_node_set(list, phys_i, prev, list_elem(src, src_i), next);
+            src_i = is_reversed ? list_prev(src, src_i) : list_next(src, src_i);
+        }
+
+        list_next(list, prev) = phys_i;
+        list_prev(list, next) = phys_i;
+
+        list->size++;
+
+        list_order_index_insert(list, prev, phys_i);
+        list_value_index_insert(list, phys_i);
+
+        list_linear_insert_(list, prev_log, phys_i);
+
+        if (i == (is_reversed ? n - 1 : 0))
+            *first_index = phys_i;
+
+        if (!is_reversed)
+            prev = phys_i;
+    }
+
+    res |= LIST_ASSERT_NODES(list, position, phys_i);
+
+    list_compact_(list, list->auto_compact_moves, first_index);
+
+    return res;
+}
+
+template <typename T>
+int list_insert_range_after(List<T>* list, const list_idx_t position, const T* elems, const size_t n,
+                            list_idx_t* first_index) {
     int res = LIST_ASSERT(list);
 
-    CHECK_AND_RETURN(list->arr[position].prev == -1, list->INVALID_POSITION);
+    CHECK_AND_RETURN(list_is_free(list, position), list->INVALID_POSITION);
+
+    CHECK_AND_RETURN(n >= (size_t)LIST_IDX_MAX, list->CAPACITY_OVERFLOW);
+
+    *first_index = -1;
+
+    if (n == 0)
+        return res;
+
+    assert(elems);
+
+    res |= list_insert_range_(list, position, elems, (const List<T>*)nullptr, 0, 0, (list_idx_t)n, first_index);
+    if (res != list->OK)
+        return res;
+
+    return res | LIST_ASSERT(list);
+}
+
+/**
+ * @brief Counts nodes of range
+ *
+ * @param list
+ * @param first physical index of the first node
+ * @param last physical index of the last node
+ * @return list_idx_t number of nodes. -1 if last doesn't follow first
+ */
+template <typename T>
+static list_idx_t list_range_size_(const List<T>* list, const list_idx_t first, const list_idx_t last) {
+    assert(list);
+
+    list_idx_t num = 1;
+
+    for (list_idx_t phys_i = first; phys_i != last; phys_i = list_next(list, phys_i), num++) {
+        if (phys_i == 0 || num > list->size)
+            return -1;
+    }
+
+    return num;
+}
+
+template <typename T>
+int list_delete_range(List<T>* list, const list_idx_t first, const list_idx_t last, const bool no_resize) {
+    int res = LIST_ASSERT(list);
+
+    CHECK_AND_RETURN(first <= 0 || list_is_free(list, first), list->INVALID_POSITION);
+    CHECK_AND_RETURN(last  <= 0 || list_is_free(list, last),  list->INVALID_POSITION);
+
+    const list_idx_t num = list_range_size_(list, first, last);
+
+    CHECK_AND_RETURN(num == -1, list->INVALID_POSITION);
+
+    const list_idx_t prev = list_prev(list, first);
+    const list_idx_t next = list_next(list, last);
+
+    list_idx_t phys_i = first;
+
+    for (list_idx_t i = 0; i < num; i++) {
+        const list_idx_t next_i = list_next(list, phys_i);
+
+        list_order_index_delete(list, phys_i);
+        list_value_index_delete(list, phys_i);
+
+        list_free_push_(list, phys_i);
+
+        phys_i = next_i;
+    }
+
+    list_next(list, prev) = next;
+    list_prev(list, next) = prev;
+
+    list->size -= num;
+
+    // linear_prefix elements are in logical order, so the following range elements are after it too
+    list_linear_delete_(list, first, num);
+
+    // all slots after linear elements are free, so they are taken in ascending order again
+    if (list->is_linear && list->linear_offset == 0)
+        list_free_reset_(list, list->size + 1);
+
+    res |= LIST_ASSERT_NODES(list, prev, next);
+
+    list_compact_(list, list->auto_compact_moves, (list_idx_t*)nullptr);
 
     if (!no_resize) {
         res |= list_resize_down(list);
@@ -300,26 +1477,128 @@ int list_delete(List* list, const size_t position, const bool no_resize) {
             return res;
     }
 
-    list->arr[list->arr[position].prev].next = list->arr[position].next;
-    list->arr[list->arr[position].next].prev = list->arr[position].prev;
+    return res | LIST_ASSERT(list);
+}
+
+template <typename T>
+int list_splice(List<T>* dst, const list_idx_t dst_pos, List<T>* src, const list_idx_t first,
+                const list_idx_t last, list_idx_t* first_index) {
+    int res = LIST_ASSERT(dst);
+    res |= LIST_ASSERT(src);
+
+    // list is the one, which error is reported for
+    List<T>* list = dst;
+
+    CHECK_AND_RETURN(list_is_free(list, dst_pos), list->INVALID_POSITION);
+
+    list = src;
+
+    CHECK_AND_RETURN(first <= 0 || list_is_free(list, first), list->INVALID_POSITION);
+    CHECK_AND_RETURN(last  <= 0 || list_is_free(list, last),  list->INVALID_POSITION);
+
+    *first_index = -1;
+
+    if (dst != src) {
+        const list_idx_t num = list_range_size_(src, first, last);
+
+        CHECK_AND_RETURN(num == -1, list->INVALID_POSITION);
+
+        // nodes are copied in one pass, then range is deleted from src
+        res |= list_insert_range_(dst, dst_pos, (const T*)nullptr, src, first, last, num, first_index);
+        if (res != dst->OK)
+            return res;
+
+        res |= list_delete_range(src, first, last);
+        if (res != src->OK)
+            return res;
+
+        return res | LIST_ASSERT(dst);
+    }
+
+#ifndef NDEBUG
+    // range must not contain dst_pos. It is checked in O(range size) only in debug mode
+    for (list_idx_t phys_i = first; ; phys_i = list_next(list, phys_i)) {
+        CHECK_AND_RETURN(phys_i == 0 || phys_i == dst_pos, list->INVALID_POSITION);
+
+        if (phys_i == last)
+            break;
+    }
+#endif //< #ifndef NDEBUG
+
+    *first_index = first;
+
+    const list_idx_t prev = list_prev(list, first);
+    const list_idx_t next = list_next(list, last);
+
+    if (prev == dst_pos)
+        return res;
+
+    list_next(list, prev) = next;
+    list_prev(list, next) = prev;
+
+    list_prev(list, first) = dst_pos;
+    list_next(list, last)  = list_next(list, dst_pos);
+
+    list_prev(list, list_next(list, dst_pos)) = last;
+    list_next(list, dst_pos) = first;
+
+    list_order_index_invalidate(list);
+
+    // elements after first and after dst_pos are moved or shifted
+    list->linear_prefix = MIN(list->linear_prefix, list_linear_log(list, first));
+    list->linear_prefix = MIN(list->linear_prefix, list_linear_log(list, dst_pos) + 1);
+
+    if (list->linear_prefix == 0)
+        list->linear_offset = 0;
+
+    list->is_linear = list->linear_prefix == list->size;
+
+    res |= LIST_ASSERT_NODES(list, prev, next);
+    res |= LIST_ASSERT_NODES(list, first, last);
+
+    list_compact_(list, list->auto_compact_moves, first_index);
+
+    return res | LIST_ASSERT(list);
+}
+
+template <typename T>
+int list_delete(List<T>* list, const list_idx_t position, const bool no_resize) {
+    int res = LIST_ASSERT(list);
+
+    CHECK_AND_RETURN(list_is_free(list, position), list->INVALID_POSITION);
 
-    list->arr[position].prev = list->UNITIALISED_VAL;
-    list->arr[position].next = list->free_head;
-    list->free_head = (ssize_t)position;
+    list_order_index_delete(list, position);
+    list_value_index_delete(list, position);
 
-    list->arr[position].elem = ListNode::POISON;
+    const list_idx_t prev = list_prev(list, position);
+    (void) prev; //< is used only in debug mode
+
+    list_next(list, list_prev(list, position)) = list_next(list, position);
+    list_prev(list, list_next(list, position)) = list_prev(list, position);
+
+    list_free_push_(list, position);
 
     list->size--;
 
-    if ((ssize_t)position != list_head(list) && (ssize_t)position != list_tail(list))
-        list->is_linear = false;
+    list_linear_delete_(list, position, 1);
+
+    res |= LIST_ASSERT_NODES(list, prev, position);
+
+    list_compact_(list, list->auto_compact_moves, (list_idx_t*)nullptr);
+
+    if (!no_resize) {
+        res |= list_resize_down(list);
+        if (res != list->OK)
+            return res;
+    }
 
     return res | LIST_ASSERT(list);
 }
 
 #ifndef NDEBUG
 
-int list_ctor_debug(List* list, const VarCodeData var_data, size_t init_capacity) {
+template <typename T>
+int list_ctor_debug(List<T>* list, const VarCodeData var_data, size_t init_capacity) {
     assert(list);
 
     list->var_data = var_data;
@@ -331,3 +1610,44 @@ int list_ctor_debug(List* list, const VarCodeData var_data, size_t init_capacity
 
 
 #undef CHECK_AND_RETURN
+
+#ifndef NDEBUG
+    #define LIST_INSTANTIATE_DEBUG_(T)                                                              \
+        template int list_ctor_debug(List<T>* list, const VarCodeData var_data, size_t init_capacity);
+#else //< #ifdef NDEBUG
+    #define LIST_INSTANTIATE_DEBUG_(T)
+#endif //< #ifndef NDEBUG
+
+#define LIST_INSTANTIATE_(T)                                                                        \
+    template int list_ctor(List<T>* list, size_t init_capacity);                                    \
+    template int list_dtor(List<T>* list);                                                          \
+    template int list_resize(List<T>* list, size_t new_capacity);                                   \
+    template int list_reserve(List<T>* list, const size_t n);                                       \
+    template int list_shrink_to_fit(List<T>* list);                                                 \
+    template int list_linearise(List<T>* list, list_idx_t new_capacity);                               \
+    template int list_compact_step(List<T>* list, const list_idx_t moves);                          \
+    template int list_find_by_logical_index(const List<T>* list, list_idx_t logical_i,                 \
+                                            list_idx_t* physical_i);                                   \
+    template int list_find_by_value(const List<T>* list, const T elem, list_idx_t* physical_i);        \
+    template int list_count_value(const List<T>* list, const T elem, list_idx_t* count);               \
+    template int list_link_locality(const List<T>* list, double* avg_distance);                        \
+    template int list_logical_index_by_physical(const List<T>* list, const list_idx_t physical_i,      \
+                                                list_idx_t* logical_i);                                \
+    template int list_verify(const List<T>* list);                                                  \
+    template int list_verify_sampled(const List<T>* list);                                          \
+    template int list_verify_nodes(const List<T>* list, const list_idx_t a, const list_idx_t b);    \
+    template int list_insert_after(List<T>* list, const list_idx_t position, const T elem,              \
+                                   list_idx_t* inserted_index);                                         \
+    template int list_insert_range_after(List<T>* list, const list_idx_t position, const T* elems,      \
+                                         const size_t n, list_idx_t* first_index);                      \
+    template int list_delete(List<T>* list, const list_idx_t position, const bool no_resize);           \
+    template int list_delete_range(List<T>* list, const list_idx_t first, const list_idx_t last,        \
+                                   const bool no_resize);                                               \
+    template int list_splice(List<T>* dst, const list_idx_t dst_pos, List<T>* src, const list_idx_t first, \
+                             const list_idx_t last, list_idx_t* first_index);                           \
+    LIST_INSTANTIATE_DEBUG_(T)
+
+LIST_ELEM_TYPES(LIST_INSTANTIATE_)
+
+#undef LIST_INSTANTIATE_
+#undef LIST_INSTANTIATE_DEBUG_
@@ -5,34 +5,129 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <assert.h>
+#include <stdint.h>
+#include <inttypes.h>
 
 #include "utils/macros.h"
+#include "list_elem_traits.h"
 
-typedef int Elem_t;
+#ifdef LIST_INDEX_32
 
-#define ELEM_T_PRINTF "%d"
+    typedef int32_t list_idx_t;             //< physical and logical index type
 
+    #define LIST_IDX_MAX INT32_MAX
+    #define LIST_IDX_PRI PRId32
+
+#else //< #ifndef LIST_INDEX_32
+
+    typedef int64_t list_idx_t;             //< physical and logical index type (for huge lists)
+
+    #define LIST_IDX_MAX INT64_MAX
+    #define LIST_IDX_PRI PRId64
+
+#endif //< #ifdef LIST_INDEX_32
+
+#ifndef LIST_VERIFY_EVERY_OPS
+    #define LIST_VERIFY_EVERY_OPS 1     //< default: full verification on every Nth LIST_ASSERT (0 - never)
+#endif //< #ifndef LIST_VERIFY_EVERY_OPS
+
+#ifndef LIST_VERIFY_EVERY_MS
+    #define LIST_VERIFY_EVERY_MS 0      //< default: full verification once in N ms (0 - never)
+#endif //< #ifndef LIST_VERIFY_EVERY_MS
+
+/**
+ * @brief List node
+ *
+ * @tparam T element type
+ */
+template <typename T>
 struct ListNode {
-    static const Elem_t POISON = __INT_MAX__ - 13;  //< poison value
-    static const ssize_t EMPTY_INDEX = -1;          //< value for prev and next
+    static constexpr T POISON = ListElemTraits<T>::POISON;  //< poison value
+    static const list_idx_t EMPTY_INDEX = -1;                  //< value for prev and next
 
-    ssize_t prev = -1;      //< previus element index
+    list_idx_t prev = -1;      //< previus element index
 
-    Elem_t elem = POISON;   //< element value
+    T elem = POISON;        //< element value
 
-    ssize_t next = -1;      //< next element index
+    list_idx_t next = -1;      //< next element index
 };
 
 // poison node
-const ListNode POISON_LIST_NODE = {ListNode::EMPTY_INDEX,
-                                   ListNode::POISON,
-                                   ListNode::EMPTY_INDEX};
+template <typename T>
+const ListNode<T> POISON_LIST_NODE = {ListNode<T>::EMPTY_INDEX,
+                                      ListNode<T>::POISON,
+                                      ListNode<T>::EMPTY_INDEX};
 
 /**
- * @brief Specifies List data
+ * @brief Returns true if elem is poison
+ *
+ * @tparam T
+ * @param elem
+ * @return true
+ * @return false
+ */
+template <typename T>
+inline bool list_is_poison(const T elem) {
+    return ListElemTraits<T>::equal(elem, ListNode<T>::POISON);
+}
+
+struct ListOrderIndex;
+struct ListValueIndex;
+struct ListFreeMap;
+
+/**
+ * @brief Memory mapping, that list data block is part of (see list_ctor_mmap and list_load_mmap)
  */
-struct List {
-    static const ssize_t UNITIALISED_VAL = -1;  //< default value
+struct ListMapping {
+    enum Kind {
+        NONE         = 0,   //< data block is allocated by list allocator
+        ANON         = 1,   //< anonymous mapping. It grows by mremap
+        FILE_PRIVATE = 2,   //< copy-on-write file mapping. Resize moves data to allocator block
+        FILE_SHARED  = 3,   //< file mapping. Resize resizes file
+    };
+
+    Kind kind = NONE;
+
+    void*  addr = nullptr;  //< mapping start
+    size_t size = 0;        //< mapping size. Anonymous mapping isn't cut, free tail pages are released
+
+    int fd = -1;            //< file of FILE_SHARED mapping
+
+    bool huge_pages = false;    //< anonymous mapping is 2 MiB aligned and advised to use huge pages
+};
+
+/**
+ * @brief Allocator of list data block. Zero allocator uses malloc, realloc and free.
+ *        Built-in allocators are in list_alloc.h
+ *
+ * @attention Allocated memory doesn't have to be zeroed. Block is aligned at least to alignof(max_align_t)
+ */
+struct ListAllocator {
+    void* (*alloc)  (void* context, const size_t size) = nullptr;
+    void* (*realloc)(void* context, void* ptr, const size_t old_size, const size_t new_size) = nullptr;
+    void  (*free)   (void* context, void* ptr, const size_t size) = nullptr;
+
+    void* context = nullptr;    //< allocator state passed to callbacks
+};
+
+/**
+ * @brief Capacity growth and shrink policy. Shrink load has to be less than 1 / growth_factor,
+ *        so list isn't shrunk right after growth, when size oscillates around capacity boundary
+ */
+struct ListResizePolicy {
+    double growth_factor = 2;       //< capacity (without fake element) is multiplied by it, when list is full
+    double shrink_load   = 0.25;    //< capacity is shrunk, when size is less than shrink_load of capacity
+
+    list_idx_t min_capacity = 0;    //< capacity isn't shrunk automatically below it
+
+    bool auto_shrink = true;        //< list_delete and list_delete_range shrink capacity
+};
+
+/**
+ * @brief Type independent List constants and error codes
+ */
+struct ListBase {
+    static const list_idx_t UNITIALISED_VAL = -1;  //< default value
     static const size_t DEFAULT_CAPACITY = 8;   //< default capacity const
 
     // error codes
@@ -55,16 +150,59 @@ struct List {
         INVALID_TAIL         = 0x100000,
         INVALID_HEAD         = 0x200000,
         INVALID_IS_LINEAR    = 0x400000,
+        CAPACITY_OVERFLOW    = 0x800000,
+        DAMAGED_FREE_LIST    = 0x1000000,
+        FILE_IO_ERR          = 0x2000000,
+        INVALID_FILE         = 0x4000000,
+        INVALID_RESIZE_POLICY= 0x8000000,
     };
+};
+
+/**
+ * @brief Specifies List data
+ *
+ * @tparam T element type
+ */
+template <typename T>
+struct List : ListBase {
+    list_idx_t free_head = UNITIALISED_VAL;    //< first free element index (0 if free list is empty)
+
+    // slots [free_watermark, capacity) are free, but they aren't in free list and aren't initialised,
+    // so pages of reserved capacity are touched only when they are used
+    list_idx_t free_watermark = UNITIALISED_VAL;
+
+#ifndef LIST_SOA
+    ListNode<T>* arr = nullptr; //< data array
+#else //< #ifdef LIST_SOA
+    // structure of arrays layout. All arrays are parts of one allocated block, that starts with next
+    list_idx_t* next = nullptr;    //< next indexes array
+    list_idx_t* prev = nullptr;    //< prev indexes array
+    T*       elem = nullptr;    //< elements array
+#endif //< #ifndef LIST_SOA
 
-    ssize_t free_head = UNITIALISED_VAL;    //< first free element index
+    list_idx_t capacity = UNITIALISED_VAL;     //< array capacity
+    list_idx_t size     = UNITIALISED_VAL;     //< number of elements in list
 
-    ListNode* arr = nullptr;    //< data array
+    bool is_linear = false; //< is list linearised (elements are stored sequentially in linear window)
 
-    ssize_t capacity = UNITIALISED_VAL;     //< array capacity
-    ssize_t size     = UNITIALISED_VAL;     //< number of elements in list
+    list_idx_t linear_prefix = UNITIALISED_VAL; //< number of first elements, that are linearised
 
-    bool is_linear = false; //< is list linearised (physical index equals sequantional number)
+    // linear window is circular: element with logical index i < linear_prefix is stored in slot
+    // 1 + (linear_offset + i) % (capacity - 1), so pushes and pops at both ends keep list linear.
+    // Growth cuts wrapped window to its unwrapped part, because elements aren't moved by resize
+    list_idx_t linear_offset = 0;
+
+    list_idx_t auto_compact_moves = 0;  //< elements moved to linear positions by every insert and delete
+
+    ListOrderIndex* order_index = nullptr;  //< optional order statistic index (list_order_index_enable)
+    ListValueIndex* value_index = nullptr;  //< optional value hash index (list_value_index_enable)
+    ListFreeMap*    free_map    = nullptr;  //< optional free slot bitmap (list_free_map_enable)
+
+    ListMapping mapping = {};   //< memory mapping of data block (list_ctor_mmap, list_load_mmap)
+
+    ListAllocator allocator = {};   //< data block allocator. It is set before list_ctor and kept by list_dtor
+
+    ListResizePolicy resize_policy = {};    //< capacity growth and shrink policy
 
 #ifndef NDEBUG
     VarCodeData var_data;   //< keeps data about list variable (name, file, line number)
@@ -72,6 +210,192 @@ struct List {
 
 };
 
+#ifndef LIST_SOA
+
+    // Node fields accessors (array of structures layout)
+
+    template <typename T>
+    inline list_idx_t& list_next(List<T>* list, const list_idx_t i) { return list->arr[i].next; }
+    template <typename T>
+    inline list_idx_t& list_prev(List<T>* list, const list_idx_t i) { return list->arr[i].prev; }
+    template <typename T>
+    inline T&       list_elem(List<T>* list, const list_idx_t i) { return list->arr[i].elem; }
+
+    template <typename T>
+    inline list_idx_t list_next(const List<T>* list, const list_idx_t i) { return list->arr[i].next; }
+    template <typename T>
+    inline list_idx_t list_prev(const List<T>* list, const list_idx_t i) { return list->arr[i].prev; }
+    template <typename T>
+    inline const T& list_elem(const List<T>* list, const list_idx_t i) { return list->arr[i].elem; }
+
+    /**
+     * @brief Returns pointer to the beginning of list data block
+     *
+     * @param list
+     * @return void*
+     */
+    template <typename T>
+    inline void* list_data(const List<T>* list) { return list->arr; }
+
+    /**
+     * @brief Returns size of data block in bytes
+     *
+     * @param capacity number of nodes
+     * @return size_t
+     */
+    template <typename T>
+    inline size_t list_data_size(const size_t capacity) { return capacity * sizeof(ListNode<T>); }
+
+    /**
+     * @brief Makes list use data block
+     *
+     * @param list
+     * @param data block of list_data_size(capacity) bytes
+     * @param capacity
+     */
+    template <typename T>
+    inline void list_data_assign(List<T>* list, void* data, const size_t capacity) {
+        (void) capacity;
+
+        list->arr = (ListNode<T>*)data;
+    }
+
+#else //< #ifdef LIST_SOA
+
+    // Node fields accessors (structure of arrays layout)
+
+    template <typename T>
+    inline list_idx_t& list_next(List<T>* list, const list_idx_t i) { return list->next[i]; }
+    template <typename T>
+    inline list_idx_t& list_prev(List<T>* list, const list_idx_t i) { return list->prev[i]; }
+    template <typename T>
+    inline T&       list_elem(List<T>* list, const list_idx_t i) { return list->elem[i]; }
+
+    template <typename T>
+    inline list_idx_t list_next(const List<T>* list, const list_idx_t i) { return list->next[i]; }
+    template <typename T>
+    inline list_idx_t list_prev(const List<T>* list, const list_idx_t i) { return list->prev[i]; }
+    template <typename T>
+    inline const T& list_elem(const List<T>* list, const list_idx_t i) { return list->elem[i]; }
+
+    /**
+     * @brief Returns pointer to the beginning of list data block
+     *
+     * @param list
+     * @return void*
+     */
+    template <typename T>
+    inline void* list_data(const List<T>* list) { return list->next; }
+
+    /**
+     * @brief Returns offset of elem array in data block in bytes
+     *
+     * @param capacity number of nodes
+     * @return size_t
+     */
+    template <typename T>
+    inline size_t list_data_elem_offset(const size_t capacity) {
+        size_t offset = 2 * capacity * sizeof(list_idx_t);
+
+        return (offset + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    /**
+     * @brief Returns size of data block in bytes
+     *
+     * @param capacity number of nodes
+     * @return size_t
+     */
+    template <typename T>
+    inline size_t list_data_size(const size_t capacity) {
+        return list_data_elem_offset<T>(capacity) + capacity * sizeof(T);
+    }
+
+    /**
+     * @brief Makes list use data block. Block layout: next[capacity], prev[capacity], elem[capacity]
+     *
+     * @param list
+     * @param data block of list_data_size(capacity) bytes
+     * @param capacity
+     */
+    template <typename T>
+    inline void list_data_assign(List<T>* list, void* data, const size_t capacity) {
+        if (data == nullptr) {
+            list->next = nullptr;
+            list->prev = nullptr;
+            list->elem = nullptr;
+            return;
+        }
+
+        list->next = (list_idx_t*)data;
+        list->prev = list->next + capacity;
+        list->elem = (T*)((char*)data + list_data_elem_offset<T>(capacity));
+    }
+
+#endif //< #ifndef LIST_SOA
+
+/**
+ * @brief Sets all node fields
+ *
+ * @param list
+ * @param i physical index
+ * @param prev
+ * @param elem
+ * @param next
+ */
+template <typename T>
+inline void list_node_set(List<T>* list, const list_idx_t i, const list_idx_t prev, const T elem,
+                          const list_idx_t next) {
+    list_prev(list, i) = prev;
+    list_elem(list, i) = elem;
+    list_next(list, i) = next;
+}
+
+/**
+ * @brief Returns true if slot is free. Free slots are over free_watermark or have negative prev
+ *        (free list back link)
+ *
+ * @param list
+ * @param i physical index
+ * @return true
+ * @return false
+ */
+template <typename T>
+inline bool list_is_free(const List<T>* list, const list_idx_t i) {
+    return i >= list->free_watermark || list_prev(list, i) < 0;
+}
+
+/**
+ * @brief Returns physical index of linear window slot
+ *
+ * @param list
+ * @param log_i index in linear window from 0 to capacity - 2 (logical index, if it is < linear_prefix)
+ * @return list_idx_t
+ */
+template <typename T>
+inline list_idx_t list_linear_phys(const List<T>* list, const list_idx_t log_i) {
+    const list_idx_t phys_i = list->linear_offset + log_i + 1;
+
+    return phys_i < list->capacity ? phys_i : phys_i - (list->capacity - 1);
+}
+
+/**
+ * @brief Returns index of slot in linear window. Slot is in linear prefix, if index is < linear_prefix
+ *
+ * @param list
+ * @param phys_i physical index
+ * @return list_idx_t logical index, if slot is in linear prefix. -1 for slot 0
+ */
+template <typename T>
+inline list_idx_t list_linear_log(const List<T>* list, const list_idx_t phys_i) {
+    if (phys_i == 0)
+        return -1;
+
+    const list_idx_t log_i = phys_i - 1 - list->linear_offset;
+
+    return log_i >= 0 ? log_i : log_i + (list->capacity - 1);
+}
+
 /**
  * @brief Returns true if list was initialised
  *
@@ -79,31 +403,34 @@ struct List {
  * @return true
  * @return false
  */
-inline bool list_is_initialised(const List* list) {
+template <typename T>
+inline bool list_is_initialised(const List<T>* list) {
     return !(list->free_head == list->UNITIALISED_VAL &&
              list->capacity  == list->UNITIALISED_VAL &&
              list->size      == list->UNITIALISED_VAL &&
-             list->is_linear == false && list->arr == nullptr);
+             list->is_linear == false && list_data(list) == nullptr);
 }
 
 /**
  * @brief Returns list head index
  *
  * @param list
- * @return ssize_t
+ * @return list_idx_t
  */
-inline ssize_t list_head(const List* list) {
-    return list->arr[0].next;
+template <typename T>
+inline list_idx_t list_head(const List<T>* list) {
+    return list_next(list, 0);
 }
 
 /**
  * @brief Returns list tail index
  *
  * @param list
- * @return ssize_t
+ * @return list_idx_t
  */
-inline ssize_t list_tail(const List* list) {
-    return list->arr[0].prev;
+template <typename T>
+inline list_idx_t list_tail(const List<T>* list) {
+    return list_prev(list, 0);
 }
 
 /**
@@ -113,7 +440,8 @@ inline ssize_t list_tail(const List* list) {
  * @param init_capacity
  * @return int
  */
-int list_ctor(List* list, size_t init_capacity = List::DEFAULT_CAPACITY);
+template <typename T>
+int list_ctor(List<T>* list, size_t init_capacity = ListBase::DEFAULT_CAPACITY);
 
 /**
  * @brief List destructor
@@ -121,7 +449,8 @@ int list_ctor(List* list, size_t init_capacity = List::DEFAULT_CAPACITY);
  * @param list
  * @return int
  */
-int list_dtor(List* list);
+template <typename T>
+int list_dtor(List<T>* list);
 
 /**
  * @brief Inserts element after physical index
@@ -132,7 +461,8 @@ int list_dtor(List* list);
  * @param inserted_index returns physical index of inserted element
  * @return int
  */
-int list_insert_after(List* list, const size_t position, const Elem_t elem, size_t* inserted_index);
+template <typename T>
+int list_insert_after(List<T>* list, const list_idx_t position, const T elem, list_idx_t* inserted_index);
 
 /**
  * @brief Inserts element before physical index
@@ -143,8 +473,9 @@ int list_insert_after(List* list, const size_t position, const Elem_t elem, size
  * @param inserted_index returns physical index of inserted element
  * @return int
  */
-inline int list_insert_before(List* list, const size_t position, const Elem_t elem, size_t* inserted_index) {
-    return list_insert_after(list, (size_t)list->arr[position].prev, elem, inserted_index);
+template <typename T>
+inline int list_insert_before(List<T>* list, const list_idx_t position, const T elem, list_idx_t* inserted_index) {
+    return list_insert_after(list, list_prev(list, position), elem, inserted_index);
 }
 
 /**
@@ -155,8 +486,9 @@ inline int list_insert_before(List* list, const size_t position, const Elem_t el
  * @param inserted_index returns physical index of inserted element
  * @return int
  */
-inline int list_pushback(List* list, const Elem_t elem, size_t* inserted_index) {
-    return list_insert_after(list, (size_t)list_tail(list), elem, inserted_index);
+template <typename T>
+inline int list_pushback(List<T>* list, const T elem, list_idx_t* inserted_index) {
+    return list_insert_after(list, list_tail(list), elem, inserted_index);
 }
 
 /**
@@ -167,8 +499,52 @@ inline int list_pushback(List* list, const Elem_t elem, size_t* inserted_index)
  * @param inserted_index returns physical index of inserted element
  * @return int
  */
-inline int list_pushfront(List* list, const Elem_t elem, size_t* inserted_index) {
-    return list_insert_before(list, (size_t)list_head(list), elem, inserted_index);
+template <typename T>
+inline int list_pushfront(List<T>* list, const T elem, list_idx_t* inserted_index) {
+    return list_insert_before(list, list_head(list), elem, inserted_index);
+}
+
+/**
+ * @brief Inserts array of elements after physical index. Capacity is increased once and, if possible,
+ *        elements take consecutive slots (appended to linear list they keep it linear)
+ *
+ * @param list
+ * @param position physical index
+ * @param elems
+ * @param n number of elements
+ * @param first_index returns physical index of the first inserted element (-1 if n is 0)
+ * @return int
+ */
+template <typename T>
+int list_insert_range_after(List<T>* list, const list_idx_t position, const T* elems, const size_t n,
+                            list_idx_t* first_index);
+
+/**
+ * @brief Inserts array of elements at the end of the list
+ *
+ * @param list
+ * @param elems
+ * @param n number of elements
+ * @param first_index returns physical index of the first inserted element (-1 if n is 0)
+ * @return int
+ */
+template <typename T>
+inline int list_pushback_range(List<T>* list, const T* elems, const size_t n, list_idx_t* first_index) {
+    return list_insert_range_after(list, list_tail(list), elems, n, first_index);
+}
+
+/**
+ * @brief Inserts array of elements at the beginning of the list
+ *
+ * @param list
+ * @param elems
+ * @param n number of elements
+ * @param first_index returns physical index of the first inserted element (-1 if n is 0)
+ * @return int
+ */
+template <typename T>
+inline int list_pushfront_range(List<T>* list, const T* elems, const size_t n, list_idx_t* first_index) {
+    return list_insert_range_after(list, 0, elems, n, first_index);
 }
 
 /**
@@ -179,7 +555,37 @@ inline int list_pushfront(List* list, const Elem_t elem, size_t* inserted_index)
  * @param no_resize will not resize down capacity if true
  * @return int
  */
-int list_delete(List* list, const size_t position, const bool no_resize = false);
+template <typename T>
+int list_delete(List<T>* list, const list_idx_t position, const bool no_resize = false);
+
+/**
+ * @brief Deletes range of elements. Range is unlinked in O(1), its slots are freed in O(range size)
+ *        and capacity is resized down at most once
+ *
+ * @param list
+ * @param first physical index of the first element
+ * @param last physical index of the last element. It must follow first in logical order
+ * @param no_resize will not resize down capacity if true
+ * @return int
+ */
+template <typename T>
+int list_delete_range(List<T>* list, const list_idx_t first, const list_idx_t last, const bool no_resize = false);
+
+/**
+ * @brief Moves range of elements of src after physical index of dst. Range inside one list is moved
+ *        in O(1). Range of another list is copied in one pass with one resize and is deleted from src
+ *
+ * @param dst
+ * @param dst_pos physical index in dst. It must not be in range, if dst is src
+ * @param src may be dst
+ * @param first physical index of the first element in src
+ * @param last physical index of the last element in src. It must follow first in logical order
+ * @param first_index returns physical index of the first moved element in dst
+ * @return int
+ */
+template <typename T>
+int list_splice(List<T>* dst, const list_idx_t dst_pos, List<T>* src, const list_idx_t first,
+                const list_idx_t last, list_idx_t* first_index);
 
 /**
  * @brief (Use macros LIST_VERIFY) Verifies list data and fields
@@ -187,25 +593,97 @@ int list_delete(List* list, const size_t position, const bool no_resize = false)
  * @param list
  * @return int
  */
-int list_verify(const List* list);
+template <typename T>
+int list_verify(const List<T>* list);
+
+/**
+ * @brief (Use macros LIST_VERIFY) Verifies list fields in O(1). Full list_verify is done only
+ *        when it is sampled (see list_verify_set_sampling)
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_verify_sampled(const List<T>* list);
 
 /**
- * @brief Resizes list (realloc)
+ * @brief (Use macros LIST_ASSERT_NODES) Verifies list fields and only nodes a and b
+ *        with their neighbours, dummy node and free head in O(1)
+ *
+ * @param list
+ * @param a
+ * @param b
+ * @return int
+ */
+template <typename T>
+int list_verify_nodes(const List<T>* list, const list_idx_t a, const list_idx_t b);
+
+/**
+ * @brief Sets how often LIST_VERIFY does full verification. Defaults are
+ *        LIST_VERIFY_EVERY_OPS and LIST_VERIFY_EVERY_MS
+ *
+ * @param every_ops full verification on every Nth check (0 - never)
+ * @param every_ms full verification once in N ms (0 - never)
+ */
+void list_verify_set_sampling(const list_idx_t every_ops, const double every_ms);
+
+/**
+ * @brief Resizes list (realloc). Physical indexes of elements are kept, so list isn't linearised.
+ *        Shrinking cuts only free tail of array
+ *
+ * @attention Growth of linear list with wrapped circular window cuts linear prefix to unwrapped part,
+ *            so list isn't linear anymore (list_linearise makes it linear again)
  *
  * @param list
  * @param new_capacity
  * @return int
  */
-int list_resize(List* list, size_t new_capacity);
+template <typename T>
+int list_resize(List<T>* list, size_t new_capacity);
+
+/**
+ * @brief Resizes capacity up, so n elements fit without resize. Capacity isn't decreased
+ *
+ * @param list
+ * @param n number of elements
+ * @return int
+ */
+template <typename T>
+int list_reserve(List<T>* list, const size_t n);
 
 /**
- * @brief Linearises array in list. Creates new array and replaces old one
+ * @brief Linearises list and resizes capacity down to size (but not below resize_policy.min_capacity)
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_shrink_to_fit(List<T>* list);
+
+/**
+ * @brief Linearises array in list in place (nodes are swapped into logical order, no second
+ *        array is allocated). Free slots are moved to the tail. Circular linear window is only rotated
  *
  * @param list
  * @param new_capacity -1 if same as old
  * @return int
  */
-int list_linearise(List* list, ssize_t new_capacity = -1);
+template <typename T>
+int list_linearise(List<T>* list, list_idx_t new_capacity = -1);
+
+/**
+ * @brief Incremental linearisation. Moves at most moves elements to their linear positions,
+ *        extending linear prefix (elements with logical index < linear_prefix are found in O(1)).
+ *        Set list.auto_compact_moves to do it on every insert and delete.
+ *
+ * @attention Moved elements change their physical indexes
+ *
+ * @param list
+ * @param moves
+ * @return int
+ */
+template <typename T>
+int list_compact_step(List<T>* list, const list_idx_t moves);
 
 /**
  * @brief Returns physical index of element with given logical index
@@ -215,7 +693,8 @@ int list_linearise(List* list, ssize_t new_capacity = -1);
  * @param physical_i returnable value. -1 if not found
  * @return int
  */
-int list_find_by_logical_index(const List* list, ssize_t logical_i, ssize_t* physical_i);
+template <typename T>
+int list_find_by_logical_index(const List<T>* list, list_idx_t logical_i, list_idx_t* physical_i);
 
 /**
  * @brief Returns physical index of element with given value (the first one)
@@ -225,7 +704,30 @@ int list_find_by_logical_index(const List* list, ssize_t logical_i, ssize_t* phy
  * @param physical_i returnable value. -1 if not found
  * @return int
  */
-int list_find_by_value(const List* list, const Elem_t elem, ssize_t* physical_i);
+template <typename T>
+int list_find_by_value(const List<T>* list, const T elem, list_idx_t* physical_i);
+
+/**
+ * @brief Counts elements with given value
+ *
+ * @param list
+ * @param elem
+ * @param count returnable value
+ * @return int
+ */
+template <typename T>
+int list_count_value(const List<T>* list, const T elem, list_idx_t* count);
+
+/**
+ * @brief Measures link locality: average |next - phys| over links of neighbouring elements in O(size).
+ *        It is 1 for linear list and grows, when neighbours are scattered over array
+ *
+ * @param list
+ * @param avg_distance returnable value. 0 if list has less than 2 elements
+ * @return int
+ */
+template <typename T>
+int list_link_locality(const List<T>* list, double* avg_distance);
 
 /**
  * @brief Returns logical index of element with specified logical index
@@ -235,25 +737,173 @@ int list_find_by_value(const List* list, const Elem_t elem, ssize_t* physical_i)
  * @param logical_i returnable value. -1 if not found
  * @return int
  */
-int list_logical_index_by_physical(const List* list, const ssize_t physical_i, ssize_t* logical_i);
+template <typename T>
+int list_logical_index_by_physical(const List<T>* list, const list_idx_t physical_i, list_idx_t* logical_i);
+
+/**
+ * @brief Constructor of list, that keeps data block in memory mapping instead of heap. Growth
+ *        remaps pages instead of copying them, shrink releases free tail pages
+ *
+ * @param list
+ * @param init_capacity
+ * @param path file to keep list in (list_save format, it is loaded by list_load_mmap).
+ *             nullptr - anonymous mapping
+ * @param huge_pages align anonymous mapping to 2 MiB and advise transparent huge pages
+ * @return int
+ */
+template <typename T>
+int list_ctor_mmap(List<T>* list, size_t init_capacity = ListBase::DEFAULT_CAPACITY,
+                   const char* path = nullptr, const bool huge_pages = false);
+
+/**
+ * @brief Saves list to binary file: versioned header (one page) and raw data block
+ *
+ * @param list
+ * @param path
+ * @return int
+ */
+template <typename T>
+int list_save(const List<T>* list, const char* path);
+
+/**
+ * @brief Loads list saved by list_save. File is mapped to memory, so only header is read
+ *        and data pages are faulted in on first access
+ *
+ * @attention Resize of MAP_PRIVATE list copies data to heap. Resize of MAP_SHARED list resizes file
+ *
+ * @param list uninitialised list
+ * @param path
+ * @param is_shared MAP_SHARED (changes are written to file) or MAP_PRIVATE (copy-on-write)
+ * @param verify run full list_verify. It is O(n) and touches every page. Without it only header
+ *               is checked, so node links of damaged file can point anywhere: use it for trusted files only
+ * @return int
+ */
+template <typename T>
+int list_load_mmap(List<T>* list, const char* path, const bool is_shared = false, const bool verify = true);
+
+/**
+ * @brief Writes list fields to header of MAP_SHARED file and flushes it. list_dtor calls it too
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_sync(List<T>* list);
+
+/**
+ * @brief list_dump parameters. Every mode except FULL prints O(k) nodes. WINDOW_LOGICAL center
+ *        outside linear prefix is found by order index if it is valid, otherwise by walk from nearer end
+ */
+struct ListDumpParams {
+    enum Mode {
+        AUTO            = 0,    //< FULL if capacity <= AUTO_FULL_MAX_CAPACITY, ENDS otherwise
+        FULL            = 1,    //< every slot
+        WINDOW_PHYSICAL = 2,    //< slots [index - k, index + k]
+        WINDOW_LOGICAL  = 3,    //< elements with logical indexes [index - k, index + k]
+        ENDS            = 4,    //< first k and last k elements
+    };
+
+    static const list_idx_t AUTO_FULL_MAX_CAPACITY = 256;
+
+    Mode mode = AUTO;
+    list_idx_t index = 0;       //< window center
+    list_idx_t k = 8;           //< window radius or number of first and last elements
+
+    bool collapse_runs = false; //< FULL mode prints runs of linear elements and free slots as one node
+};
 
 /**
  * @brief (Use LIST_DUMP macros) Dumps list data to log
  *
  * @param list
  * @param call_data
+ * @param params dumped part of list
  */
-void list_dump(const List* list, const VarCodeData call_data);
+template <typename T>
+void list_dump(const List<T>* list, const VarCodeData call_data, const ListDumpParams params = {});
 
 /**
  * @brief Dumps list array to dot file
  *
  * @param list
  * @param img_filename returns image filename
+ * @param params dumped part of list
+ * @return true
+ * @return false
+ */
+template <typename T>
+bool list_dump_dot(const List<T>* list, char* img_filename, const ListDumpParams params = {});
+
+/**
+ * @brief Starts deferred dump mode. After it list_dump only copies list header and data to
+ *        preallocated ring of snapshots. The oldest snapshots are overwritten, when ring is full
+ *
+ * @param bytes ring size
+ * @return true success
+ * @return false allocation error
+ */
+bool list_dump_ring_start(const size_t bytes);
+
+/**
+ * @brief Returns true if list_dump stores snapshots to ring
+ *
  * @return true
  * @return false
  */
-bool list_dump_dot(const List* list, char* img_filename);
+bool list_dump_ring_is_active();
+
+/**
+ * @brief (Use LIST_DUMP macros) Copies list snapshot to ring
+ *
+ * @param list
+ * @param call_data
+ * @param params dumped part of list (it is applied, when snapshot is rendered)
+ * @return true success
+ * @return false snapshot is bigger than ring
+ */
+template <typename T>
+bool list_dump_ring_push(const List<T>* list, const VarCodeData call_data, const ListDumpParams params);
+
+/**
+ * @brief Returns number of stored snapshots
+ *
+ * @return size_t
+ */
+size_t list_dump_ring_size();
+
+/**
+ * @brief Renders stored snapshots (oldest first) to log the same way as list_dump does and
+ *        clears ring
+ *
+ * @return true success
+ * @return false failure
+ */
+bool list_dump_ring_render();
+
+/**
+ * @brief Saves stored snapshots to binary file. It is rendered by dump_render tool
+ *
+ * @attention File can be rendered only by tool built with the same list build options
+ *
+ * @param filename
+ * @return true success
+ * @return false failure
+ */
+bool list_dump_ring_save(const char* filename);
+
+/**
+ * @brief Replaces ring with snapshots from file written by list_dump_ring_save
+ *
+ * @param filename
+ * @return true success
+ * @return false failure
+ */
+bool list_dump_ring_load(const char* filename);
+
+/**
+ * @brief Frees ring. list_dump renders synchronously after it
+ */
+void list_dump_ring_stop();
 
 /**
  * @brief Prints text error to log by error code
@@ -272,7 +922,8 @@ void list_print_error(const int err_code);
      * @param init_capacity
      * @return int
      */
-    int list_ctor_debug(List* list, const VarCodeData var_data, size_t init_capacity = List::DEFAULT_CAPACITY);
+    template <typename T>
+    int list_ctor_debug(List<T>* list, const VarCodeData var_data, size_t init_capacity = ListBase::DEFAULT_CAPACITY);
 
     /**
      * @brief Constructor
@@ -289,11 +940,11 @@ void list_print_error(const int err_code);
     #define LIST_CTOR_CAP(list, cap) list_ctor_debug(list, VAR_CODE_DATA_PTR(list), cap)
 
     /**
-     * @brief Verifies list data and fields
+     * @brief Verifies list fields. Full verification is sampled
      *
      * @param list
      */
-    #define LIST_VERIFY(list) list_verify(list)
+    #define LIST_VERIFY(list) list_verify_sampled(list)
 
     /**
      * @brief List assert macros (LIST_VERIFY, LIST_OK, and if not ok - return)
@@ -308,16 +959,31 @@ void list_print_error(const int err_code);
                     return res
 
     /**
-     * @brief Checks if res is OK, if not, prints error and dump
+     * @brief List assert macros for nodes, changed by operation (list_verify_nodes)
+     *
+     * @param list
+     * @param a
+     * @param b
+     */
+    #define LIST_ASSERT_NODES(list, a, b)           \
+                list_verify_nodes(list, a, b);      \
+                LIST_OK(list, res);                 \
+                                                    \
+                if (res != list->OK)                \
+                    return res
+
+    /**
+     * @brief Checks if res is OK, if not, prints error and dump. Deferred dumps are rendered too
      *
      * @param list
      * @param res
      */
-    #define LIST_OK(list, res)   do {                           \
-                                    if (res != list->OK) {      \
-                                        list_print_error(res);  \
-                                        LIST_DUMP(list);        \
-                                    }                           \
+    #define LIST_OK(list, res)   do {                               \
+                                    if (res != list->OK) {          \
+                                        list_print_error(res);      \
+                                        LIST_DUMP(list);            \
+                                        list_dump_ring_render();    \
+                                    }                               \
                                 } while (0)
 
     /**
@@ -327,6 +993,14 @@ void list_print_error(const int err_code);
      */
     #define LIST_DUMP(list) list_dump(list, VAR_CODE_DATA())
 
+    /**
+     * @brief Prints part of list dump to log
+     *
+     * @param list
+     * @param params ListDumpParams
+     */
+    #define LIST_DUMP_PARAMS(list, params) list_dump(list, VAR_CODE_DATA(), params)
+
 #else //< #ifdef NDEBUG
 
     /**
@@ -348,7 +1022,7 @@ void list_print_error(const int err_code);
      *
      * @param list
      */
-    #define LIST_VERIFY(list) List::OK
+    #define LIST_VERIFY(list) ListBase::OK
 
     /**
      * @brief List assert macros (enabled only in DEBUG mode)
@@ -357,6 +1031,15 @@ void list_print_error(const int err_code);
      */
     #define LIST_ASSERT(list) 0
 
+    /**
+     * @brief List assert macros for nodes, changed by operation (enabled only in DEBUG mode)
+     *
+     * @param list
+     * @param a
+     * @param b
+     */
+    #define LIST_ASSERT_NODES(list, a, b) 0
+
     /**
      * @brief Checks if res is OK (enabled only in DEBUG mode)
      *
@@ -372,21 +1055,48 @@ void list_print_error(const int err_code);
      */
     #define LIST_DUMP(list) (void) 0
 
+    /**
+     * @brief Prints part of list dump to log (enabled only in DEBUG mode)
+     *
+     * @param list
+     * @param params ListDumpParams
+     */
+    #define LIST_DUMP_PARAMS(list, params) (void) 0
+
 #endif //< #ifndef NDEBUG
 
 /**
- * @brief Checks if list capacity is low and resizes it
+ * @brief Checks if list capacity is low for new elements and resizes it once
  *
  * @param list
+ * @param new_elems number of elements, that are going to be inserted
  * @return int
  */
-inline int list_resize_up(List* list) {
+template <typename T>
+inline int list_resize_up(List<T>* list, const list_idx_t new_elems = 1) {
     int res = LIST_ASSERT(list);
 
-    ssize_t new_capacity = list->capacity;
+    // the same capacity as after new_elems single inserts
+    const int64_t last_size = (int64_t)list->size + new_elems - 1;
+
+    int64_t new_capacity = list->capacity;
+
+    while (last_size >= new_capacity - 1 - 1) {
+        const double grown = (double)(new_capacity - 1) * list->resize_policy.growth_factor + 1;
+
+        if (grown >= (double)LIST_IDX_MAX) {
+            if (last_size >= LIST_IDX_MAX - 1 - 1) {
+                res |= list->CAPACITY_OVERFLOW;
+                LIST_OK(list, res);
+                return res;
+            }
+
+            new_capacity = LIST_IDX_MAX;
+            break;
+        }
 
-    while (list->size >= new_capacity - 1 - 1)
-        new_capacity = (new_capacity - 1) * 2 + 1;
+        new_capacity = MAX((int64_t)grown, new_capacity + 1);
+    }
 
     if (new_capacity != list->capacity)
         return res | list_resize(list, (size_t)new_capacity);
@@ -395,27 +1105,37 @@ inline int list_resize_up(List* list) {
 }
 
 /**
- * @brief Checks if list capacity is too big and resizes it
+ * @brief Checks if list capacity is too big and resizes it (see ListResizePolicy)
  *
  * @param list
  * @return int
  */
-inline int list_resize_down(List* list) {
+template <typename T>
+inline int list_resize_down(List<T>* list) {
     int res = LIST_ASSERT(list);
 
-    ssize_t new_capacity = list->capacity;
+    const ListResizePolicy* policy = &list->resize_policy;
 
-    while (list->size < (new_capacity - 1) / 2)
-        new_capacity = (new_capacity - 1) / 2 + 1;
+    if (!policy->auto_shrink)
+        return res;
 
-    if (new_capacity != list->capacity)
+    // load after shrink is in [shrink_load, shrink_load * growth_factor), so it is far from both boundaries
+    list_idx_t new_capacity = list->capacity;
+
+    while ((double)list->size < policy->shrink_load * (double)(new_capacity - 1) &&
+           new_capacity > policy->min_capacity + 1)
+        new_capacity = (list_idx_t)((double)(new_capacity - 1) / policy->growth_factor) + 1;
+
+    new_capacity = MAX(new_capacity, policy->min_capacity + 1);
+
+    if (new_capacity < list->capacity)
         return res | list_resize(list, (size_t)new_capacity);
 
     return res;
 }
 
 #define LIST_FOREACH(list_, phys_i_, log_i_)                            \
-    for (; phys_i_ > 0 && log_i_ <= (list_).size; phys_i_ = (list_).arr[phys_i_].next, (log_i_)++)
+    for (; phys_i_ > 0 && log_i_ <= (list_).size; phys_i_ = list_next(&(list_), phys_i_), (log_i_)++)
 
 #define LIST_IS_FOREACH_VALID(list_, log_i_, ...)   do {    \
             if (log_i_ != (list_).size) {                   \
@@ -0,0 +1,385 @@
+#include "list_alloc.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif //< #ifdef __linux__
+
+static const size_t LIST_ALLOC_ALIGN = alignof(max_align_t);  //< alignment of arena and pool blocks
+static const size_t LIST_ALLOC_HUGE_PAGE_SIZE = 2 << 20;
+
+/**
+ * @brief Rounds size up to align
+ *
+ * @param size
+ * @param align
+ * @return size_t
+ */
+static size_t list_alloc_round_up_(const size_t size, const size_t align) {
+    return (size + align - 1) / align * align;
+}
+
+// Bump arena
+
+static const size_t LIST_ARENA_HEADER_SIZE = (sizeof(ListArena::Chunk) + LIST_ALLOC_ALIGN - 1) /
+                                             LIST_ALLOC_ALIGN * LIST_ALLOC_ALIGN;
+
+/**
+ * @brief Returns beginning of chunk data
+ *
+ * @param chunk
+ * @return char*
+ */
+static char* list_arena_chunk_data_(ListArena::Chunk* chunk) {
+    assert(chunk);
+
+    return (char*)chunk + LIST_ARENA_HEADER_SIZE;
+}
+
+/**
+ * @brief Allocates new current chunk
+ *
+ * @param arena
+ * @param size chunk data size
+ * @return true success
+ * @return false allocation error
+ */
+static bool list_arena_add_chunk_(ListArena* arena, const size_t size) {
+    assert(arena);
+
+    ListArena::Chunk* chunk = (ListArena::Chunk*)malloc(LIST_ARENA_HEADER_SIZE + size);
+
+    if (chunk == nullptr)
+        return false;
+
+    chunk->prev = arena->chunk;
+    chunk->size = size;
+    chunk->used = 0;
+
+    arena->chunk = chunk;
+
+    return true;
+}
+
+/**
+ * @brief Frees all chunks
+ *
+ * @param arena
+ * @return size_t total data size of freed chunks
+ */
+static size_t list_arena_free_chunks_(ListArena* arena) {
+    assert(arena);
+
+    size_t total_size = 0;
+
+    while (arena->chunk != nullptr) {
+        ListArena::Chunk* prev = arena->chunk->prev;
+
+        total_size += arena->chunk->size;
+        free(arena->chunk);
+
+        arena->chunk = prev;
+    }
+
+    arena->last = nullptr;
+
+    return total_size;
+}
+
+static void* list_arena_alloc_(void* context, const size_t size) {
+    ListArena* arena = (ListArena*)context;
+    assert(arena);
+
+    const size_t block_size = list_alloc_round_up_(size, LIST_ALLOC_ALIGN);
+
+    if (arena->chunk == nullptr || arena->chunk->size - arena->chunk->used < block_size) {
+        if (!list_arena_add_chunk_(arena, MAX(arena->chunk_size, block_size)))
+            return nullptr;
+    }
+
+    ListArena::Chunk* chunk = arena->chunk;
+
+    void* block = list_arena_chunk_data_(chunk) + chunk->used;
+    chunk->used += block_size;
+
+    arena->last = block;
+
+    return block;
+}
+
+static void* list_arena_realloc_(void* context, void* ptr, const size_t old_size, const size_t new_size) {
+    ListArena* arena = (ListArena*)context;
+    assert(arena);
+
+    // last block is always in current chunk, so it can be resized in place
+    if (ptr != nullptr && ptr == arena->last) {
+        ListArena::Chunk* chunk = arena->chunk;
+
+        const size_t offset = (size_t)((char*)ptr - list_arena_chunk_data_(chunk));
+        const size_t block_size = list_alloc_round_up_(new_size, LIST_ALLOC_ALIGN);
+
+        if (offset + block_size <= chunk->size) {
+            chunk->used = offset + block_size;
+            return ptr;
+        }
+    }
+
+    // old block is freed only by reset
+    void* new_ptr = list_arena_alloc_(context, new_size);
+
+    if (new_ptr == nullptr)
+        return nullptr;
+
+    if (ptr != nullptr)
+        memcpy(new_ptr, ptr, MIN(old_size, new_size));
+
+    return new_ptr;
+}
+
+static void list_arena_free_(void* context, void* ptr, const size_t size) {
+    ListArena* arena = (ListArena*)context;
+    assert(arena);
+
+    (void) size;
+
+    if (ptr == nullptr || ptr != arena->last)
+        return;
+
+    arena->chunk->used = (size_t)((char*)ptr - list_arena_chunk_data_(arena->chunk));
+    arena->last = nullptr;
+}
+
+bool list_arena_ctor(ListArena* arena, const size_t chunk_size) {
+    assert(arena);
+    assert(chunk_size > 0);
+
+    *arena = {};
+
+    arena->chunk_size = chunk_size;
+
+    return list_arena_add_chunk_(arena, chunk_size);
+}
+
+void list_arena_reset(ListArena* arena) {
+    assert(arena);
+
+    arena->last = nullptr;
+
+    if (arena->chunk == nullptr)
+        return;
+
+    if (arena->chunk->prev == nullptr) {
+        arena->chunk->used = 0;
+        return;
+    }
+
+    // request didn't fit in one chunk
+    const size_t total_size = list_arena_free_chunks_(arena);
+
+    arena->chunk_size = MAX(arena->chunk_size, total_size);
+
+    // on failure chunk is allocated by the next allocation
+    list_arena_add_chunk_(arena, arena->chunk_size);
+}
+
+void list_arena_dtor(ListArena* arena) {
+    assert(arena);
+
+    list_arena_free_chunks_(arena);
+
+    *arena = {};
+}
+
+ListAllocator list_arena_allocator(ListArena* arena) {
+    assert(arena);
+
+    ListAllocator allocator = {};
+
+    allocator.alloc   = list_arena_alloc_;
+    allocator.realloc = list_arena_realloc_;
+    allocator.free    = list_arena_free_;
+    allocator.context = arena;
+
+    return allocator;
+}
+
+// Power of two block pool
+
+/**
+ * @brief Returns size class of block
+ *
+ * @param size
+ * @return size_t class index. CLASSES_NUM if block is too big
+ */
+static size_t list_block_pool_class_(const size_t size) {
+    size_t class_i = 0;
+
+    while (class_i < ListBlockPool::CLASSES_NUM && (ListBlockPool::MIN_BLOCK_SIZE << class_i) < size)
+        class_i++;
+
+    return class_i;
+}
+
+static void* list_block_pool_alloc_(void* context, const size_t size) {
+    ListBlockPool* pool = (ListBlockPool*)context;
+    assert(pool);
+
+    const size_t class_i = list_block_pool_class_(size);
+
+    if (class_i >= ListBlockPool::CLASSES_NUM)
+        return nullptr;
+
+    const size_t block_size = ListBlockPool::MIN_BLOCK_SIZE << class_i;
+
+    void* block = pool->free_blocks[class_i];
+
+    if (block == nullptr)
+        return malloc(block_size);
+
+    // free block keeps next free block in its beginning
+    memcpy(&pool->free_blocks[class_i], block, sizeof(void*));
+    pool->cached_size -= block_size;
+
+    return block;
+}
+
+static void list_block_pool_free_(void* context, void* ptr, const size_t size) {
+    ListBlockPool* pool = (ListBlockPool*)context;
+    assert(pool);
+
+    if (ptr == nullptr)
+        return;
+
+    const size_t class_i = list_block_pool_class_(size);
+    assert(class_i < ListBlockPool::CLASSES_NUM);
+
+    memcpy(ptr, &pool->free_blocks[class_i], sizeof(void*));
+    pool->free_blocks[class_i] = ptr;
+
+    pool->cached_size += ListBlockPool::MIN_BLOCK_SIZE << class_i;
+}
+
+static void* list_block_pool_realloc_(void* context, void* ptr, const size_t old_size, const size_t new_size) {
+    assert(context);
+
+    // block already has size of its class
+    if (ptr != nullptr && list_block_pool_class_(old_size) == list_block_pool_class_(new_size))
+        return ptr;
+
+    void* new_ptr = list_block_pool_alloc_(context, new_size);
+
+    if (new_ptr == nullptr)
+        return nullptr;
+
+    if (ptr != nullptr) {
+        memcpy(new_ptr, ptr, MIN(old_size, new_size));
+        list_block_pool_free_(context, ptr, old_size);
+    }
+
+    return new_ptr;
+}
+
+void list_block_pool_trim(ListBlockPool* pool) {
+    assert(pool);
+
+    for (size_t class_i = 0; class_i < ListBlockPool::CLASSES_NUM; class_i++) {
+        while (pool->free_blocks[class_i] != nullptr) {
+            void* block = pool->free_blocks[class_i];
+
+            memcpy(&pool->free_blocks[class_i], block, sizeof(void*));
+            free(block);
+        }
+    }
+
+    pool->cached_size = 0;
+}
+
+void list_block_pool_dtor(ListBlockPool* pool) {
+    assert(pool);
+
+    list_block_pool_trim(pool);
+}
+
+ListAllocator list_block_pool_allocator(ListBlockPool* pool) {
+    assert(pool);
+
+    ListAllocator allocator = {};
+
+    allocator.alloc   = list_block_pool_alloc_;
+    allocator.realloc = list_block_pool_realloc_;
+    allocator.free    = list_block_pool_free_;
+    allocator.context = pool;
+
+    return allocator;
+}
+
+// Aligned and huge page allocator
+
+static void* list_aligned_alloc_(void* context, const size_t size) {
+    const ListAlignedParams* params = (const ListAlignedParams*)context;
+    assert(params);
+    assert(params->alignment >= sizeof(void*) && (params->alignment & (params->alignment - 1)) == 0);
+
+    const bool is_huge = params->huge_pages && size >= LIST_ALLOC_HUGE_PAGE_SIZE;
+
+    const size_t align = is_huge ? MAX(params->alignment, LIST_ALLOC_HUGE_PAGE_SIZE) : params->alignment;
+    const size_t block_size = list_alloc_round_up_(size, align);
+
+#ifdef _WIN32
+    void* block = _aligned_malloc(block_size, align);
+#else //< #ifndef _WIN32
+    void* block = nullptr;
+
+    if (posix_memalign(&block, align, block_size) != 0)
+        return nullptr;
+#endif //< #ifdef _WIN32
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // huge pages are only a hint, so errors are ignored
+    if (is_huge && block != nullptr)
+        madvise(block, block_size, MADV_HUGEPAGE);
+#endif //< #if defined(__linux__) && defined(MADV_HUGEPAGE)
+
+    return block;
+}
+
+static void list_aligned_free_(void* context, void* ptr, const size_t size) {
+    (void) context;
+    (void) size;
+
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else //< #ifndef _WIN32
+    free(ptr);
+#endif //< #ifdef _WIN32
+}
+
+static void* list_aligned_realloc_(void* context, void* ptr, const size_t old_size, const size_t new_size) {
+    // there is no aligned realloc, so block is copied
+    void* new_ptr = list_aligned_alloc_(context, new_size);
+
+    if (new_ptr == nullptr)
+        return nullptr;
+
+    if (ptr != nullptr) {
+        memcpy(new_ptr, ptr, MIN(old_size, new_size));
+        list_aligned_free_(context, ptr, old_size);
+    }
+
+    return new_ptr;
+}
+
+ListAllocator list_aligned_allocator(ListAlignedParams* params) {
+    assert(params);
+
+    ListAllocator allocator = {};
+
+    allocator.alloc   = list_aligned_alloc_;
+    allocator.realloc = list_aligned_realloc_;
+    allocator.free    = list_aligned_free_;
+    allocator.context = params;
+
+    return allocator;
+}
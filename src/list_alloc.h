@@ -0,0 +1,163 @@
+#ifndef LIST_ALLOC_H_
+#define LIST_ALLOC_H_
+
+#include "list.h"
+
+/**
+ * @brief Allocates block by allocator
+ *
+ * @param allocator
+ * @param size
+ * @return void* nullptr on failure
+ */
+inline void* list_allocator_alloc(const ListAllocator* allocator, const size_t size) {
+    assert(allocator);
+
+    if (allocator->alloc == nullptr)
+        return malloc(size);
+
+    return allocator->alloc(allocator->context, size);
+}
+
+/**
+ * @brief Resizes block by allocator
+ *
+ * @param allocator
+ * @param ptr
+ * @param old_size
+ * @param new_size
+ * @return void* nullptr on failure (old block stays valid)
+ */
+inline void* list_allocator_realloc(const ListAllocator* allocator, void* ptr, const size_t old_size,
+                                   const size_t new_size) {
+    assert(allocator);
+
+    if (allocator->realloc == nullptr)
+        return realloc(ptr, new_size);
+
+    return allocator->realloc(allocator->context, ptr, old_size, new_size);
+}
+
+/**
+ * @brief Frees block by allocator
+ *
+ * @param allocator
+ * @param ptr
+ * @param size
+ */
+inline void list_allocator_free(const ListAllocator* allocator, void* ptr, const size_t size) {
+    assert(allocator);
+
+    if (allocator->free == nullptr)
+        free(ptr);
+    else
+        allocator->free(allocator->context, ptr, size);
+}
+
+/**
+ * @brief Bump arena. Blocks are cut from chunk one after another and are freed all together by
+ *        list_arena_reset, so lists of one request are created and destroyed without heap calls
+ *
+ * @attention Lists have to be destroyed before reset
+ */
+struct ListArena {
+    struct Chunk {
+        Chunk* prev = nullptr;  //< previously filled chunk
+        size_t size = 0;        //< chunk data size (data follows header)
+        size_t used = 0;        //< used data bytes
+    };
+
+    Chunk* chunk = nullptr;     //< current chunk
+    size_t chunk_size = 0;      //< minimal size of new chunk
+
+    void* last = nullptr;       //< last allocated block. Only it is resized and freed in place
+};
+
+/**
+ * @brief Arena constructor
+ *
+ * @param arena
+ * @param chunk_size size of the first chunk. It should fit all lists of request
+ * @return true success
+ * @return false allocation error
+ */
+bool list_arena_ctor(ListArena* arena, const size_t chunk_size);
+
+/**
+ * @brief Frees all blocks. If request didn't fit in one chunk, chunks are replaced by one chunk
+ *        of their total size, so the next request fits
+ *
+ * @param arena
+ */
+void list_arena_reset(ListArena* arena);
+
+/**
+ * @brief Arena destructor
+ *
+ * @param arena
+ */
+void list_arena_dtor(ListArena* arena);
+
+/**
+ * @brief Returns list allocator, that cuts data blocks from arena
+ *
+ * @param arena
+ * @return ListAllocator
+ */
+ListAllocator list_arena_allocator(ListArena* arena);
+
+/**
+ * @brief Pool of blocks of power of two sizes. Freed blocks are kept in free lists by size class and
+ *        are reused by allocations of the same class. Capacities (2^k + 1) of list_resize_up always fall
+ *        into the same classes, so lists created and destroyed again and again don't call malloc
+ */
+struct ListBlockPool {
+    static const size_t MIN_BLOCK_SIZE = 64;    //< size of the smallest class
+    static const size_t CLASSES_NUM = 48;
+
+    void* free_blocks[CLASSES_NUM] = {};    //< free list of every class. Free block keeps next free block
+
+    size_t cached_size = 0;     //< total size of free blocks
+};
+
+/**
+ * @brief Frees cached blocks. Blocks, that are used by lists, stay valid
+ *
+ * @param pool
+ */
+void list_block_pool_trim(ListBlockPool* pool);
+
+/**
+ * @brief Pool destructor. Lists using pool have to be destroyed before
+ *
+ * @param pool
+ */
+void list_block_pool_dtor(ListBlockPool* pool);
+
+/**
+ * @brief Returns list allocator, that takes data blocks from pool
+ *
+ * @param pool
+ * @return ListAllocator
+ */
+ListAllocator list_block_pool_allocator(ListBlockPool* pool);
+
+/**
+ * @brief Aligned allocator parameters
+ */
+struct ListAlignedParams {
+    size_t alignment = 64;      //< power of two (cache line by default)
+
+    bool huge_pages = false;    //< blocks from 2 MiB are 2 MiB aligned and advised to use huge pages
+};
+
+/**
+ * @brief Returns list allocator of aligned blocks. Resize copies block
+ *        (list_ctor_mmap grows huge list without copying)
+ *
+ * @param params it is used by allocator, so it has to outlive lists
+ * @return ListAllocator
+ */
+ListAllocator list_aligned_allocator(ListAlignedParams* params);
+
+#endif //< #ifndef LIST_ALLOC_H_
@@ -0,0 +1,601 @@
+#include "list.h"
+
+#include <stddef.h>
+
+#include "list_log/list_log.h"
+#include "utils/html.h"
+#include "utils/ptr_valid.h"
+
+extern ListLogFileData list_log_file;
+
+#ifndef NDEBUG
+
+static const size_t LIST_DUMP_RING_ALIGN = alignof(max_align_t);   //< every record part is aligned
+
+static const char     LIST_DUMP_RING_MAGIC[8] = "LISTRNG";
+static const uint32_t LIST_DUMP_RING_VERSION  = 1;
+
+/**
+ * @brief Snapshot header. It is followed by copy of List<T>, copy of list data block and
+ *        strings of call_data and var_data (only in loaded snapshots)
+ */
+struct ListDumpRecord {
+    size_t bytes = 0;           //< whole record size
+    size_t number = 0;          //< dump sequence number
+
+    int type = -1;              //< element type (position in LIST_ELEM_TYPES)
+
+    size_t list_bytes    = 0;   //< sizeof(List<T>)
+    size_t data_bytes    = 0;   //< 0 if list data pointer was invalid
+    size_t strings_bytes = 0;
+
+    const void* list_ptr = nullptr;
+
+    VarCodeData call_data = {};
+    VarCodeData var_data  = {};
+
+    ListDumpParams params = {};
+};
+
+/**
+ * @brief Ring of snapshots. Records are never split: if record doesn't fit in the end of
+ *        buffer, it is written to the beginning
+ */
+struct ListDumpRing {
+    char* buf = nullptr;
+    size_t cap = 0;
+
+    size_t begin = 0;           //< oldest record offset
+    size_t end   = 0;           //< next record offset
+    size_t wrap  = 0;           //< end of records in the end of buffer (if is_wrapped)
+    bool is_wrapped = false;    //< records are stored in [begin, wrap) and [0, end)
+
+    size_t num = 0;             //< number of stored records
+
+    size_t pushed      = 0;     //< number of pushed snapshots
+    size_t overwritten = 0;     //< number of snapshots, that were overwritten before render
+    size_t dropped     = 0;     //< number of snapshots bigger than ring
+
+    bool is_rendering = false;  //< list_dump renders synchronously while ring is rendered
+};
+
+/**
+ * @brief Saved ring file header
+ */
+struct ListDumpRingFileHeader {
+    char magic[sizeof(LIST_DUMP_RING_MAGIC)] = {};
+    uint32_t version = 0;
+
+    // list build options
+    uint32_t idx_size = 0;
+    uint32_t is_soa = 0;
+    uint32_t record_size = 0;
+
+    uint64_t num = 0;
+    uint64_t overwritten = 0;
+    uint64_t dropped = 0;
+};
+
+static ListDumpRing list_dump_ring = {};
+
+/**
+ * @brief Rounds size up to LIST_DUMP_RING_ALIGN
+ *
+ * @param size
+ * @return size_t
+ */
+static size_t list_dump_ring_align_(const size_t size) {
+    return (size + LIST_DUMP_RING_ALIGN - 1) / LIST_DUMP_RING_ALIGN * LIST_DUMP_RING_ALIGN;
+}
+
+/**
+ * @brief Returns record size
+ *
+ * @param list_bytes
+ * @param data_bytes
+ * @param strings_bytes
+ * @return size_t
+ */
+static size_t list_dump_record_size_(const size_t list_bytes, const size_t data_bytes, const size_t strings_bytes) {
+    return list_dump_ring_align_(sizeof(ListDumpRecord)) + list_dump_ring_align_(list_bytes) +
+           list_dump_ring_align_(data_bytes) + list_dump_ring_align_(strings_bytes);
+}
+
+// record parts
+
+static char* list_dump_record_list_(ListDumpRecord* rec) {
+    return (char*)rec + list_dump_ring_align_(sizeof(ListDumpRecord));
+}
+
+static char* list_dump_record_data_(ListDumpRecord* rec) {
+    return list_dump_record_list_(rec) + list_dump_ring_align_(rec->list_bytes);
+}
+
+static char* list_dump_record_strings_(ListDumpRecord* rec) {
+    return list_dump_record_data_(rec) + list_dump_ring_align_(rec->data_bytes);
+}
+
+/**
+ * @brief Removes the oldest record
+ *
+ * @param ring
+ */
+static void list_dump_ring_pop_(ListDumpRing* ring) {
+    assert(ring);
+    assert(ring->num > 0);
+
+    ring->begin += ((ListDumpRecord*)(ring->buf + ring->begin))->bytes;
+    ring->num--;
+
+    if (ring->is_wrapped && ring->begin == ring->wrap) {
+        ring->begin = 0;
+        ring->is_wrapped = false;
+    }
+
+    if (ring->num == 0) {
+        ring->begin = 0;
+        ring->end   = 0;
+        ring->is_wrapped = false;
+    }
+}
+
+/**
+ * @brief Allocates record in ring. The oldest records are overwritten
+ *
+ * @param bytes record size
+ * @return ListDumpRecord* nullptr if record is bigger than ring
+ */
+static ListDumpRecord* list_dump_ring_reserve_(const size_t bytes) {
+    ListDumpRing* ring = &list_dump_ring;
+
+    if (bytes > ring->cap)
+        return nullptr;
+
+    while (true) {
+        if (!ring->is_wrapped) {
+            if (ring->end + bytes <= ring->cap)
+                break;
+
+            // records [begin, end) stay in the end of buffer
+            ring->wrap = ring->end;
+            ring->end  = 0;
+            ring->is_wrapped = ring->num > 0;
+
+            if (!ring->is_wrapped)
+                ring->begin = 0;
+
+            continue;
+        }
+
+        if (ring->end + bytes <= ring->begin)
+            break;
+
+        list_dump_ring_pop_(ring);
+        ring->overwritten++;
+    }
+
+    ListDumpRecord* rec = (ListDumpRecord*)(ring->buf + ring->end);
+
+    ring->end += bytes;
+    ring->num++;
+
+    *rec = {};
+    rec->bytes = bytes;
+
+    return rec;
+}
+
+/**
+ * @brief Returns next record offset (records are iterated from the oldest)
+ *
+ * @param ring
+ * @param offset
+ * @return size_t
+ */
+static size_t list_dump_ring_next_(const ListDumpRing* ring, size_t offset) {
+    assert(ring);
+
+    offset += ((ListDumpRecord*)(ring->buf + offset))->bytes;
+
+    if (ring->is_wrapped && offset == ring->wrap)
+        offset = 0;
+
+    return offset;
+}
+
+bool list_dump_ring_start(const size_t bytes) {
+    list_dump_ring_stop();
+
+    list_dump_ring.buf = (char*)calloc(bytes, 1);
+
+    if (list_dump_ring.buf == nullptr)
+        return false;
+
+    list_dump_ring.cap = bytes;
+
+    return true;
+}
+
+bool list_dump_ring_is_active() {
+    return list_dump_ring.buf != nullptr && !list_dump_ring.is_rendering;
+}
+
+template <typename T>
+bool list_dump_ring_push(const List<T>* list, const VarCodeData call_data, const ListDumpParams params) {
+    assert(list);
+
+    ListDumpRing* ring = &list_dump_ring;
+
+    void* data = list_data(list);
+    size_t data_bytes = 0;
+
+    if (list->capacity > 0 && data != nullptr && is_ptr_valid(data))
+        data_bytes = list_data_size<T>((size_t)list->capacity);
+
+    ListDumpRecord* rec = list_dump_ring_reserve_(list_dump_record_size_(sizeof(List<T>), data_bytes, 0));
+
+    if (rec == nullptr) {
+        ring->dropped++;
+        return false;
+    }
+
+    rec->number     = ring->pushed++;
+    rec->type       = list_elem_type_id<T>();
+    rec->list_bytes = sizeof(List<T>);
+    rec->data_bytes = data_bytes;
+    rec->list_ptr   = list;
+    rec->call_data  = call_data;
+    rec->var_data   = list->var_data;
+    rec->params     = params;
+
+    memcpy(list_dump_record_list_(rec), list, sizeof(List<T>));
+
+    if (data_bytes > 0)
+        memcpy(list_dump_record_data_(rec), data, data_bytes);
+
+    return true;
+}
+
+size_t list_dump_ring_size() {
+    return list_dump_ring.num;
+}
+
+/**
+ * @brief Checks, that record parts sizes match list copy in it and that list fields, which are
+ *        used as slot indexes by dump, are in data block
+ *
+ * @param rec
+ * @return true
+ * @return false snapshot is damaged
+ */
+template <typename T>
+static bool list_dump_record_is_valid_typed_(ListDumpRecord* rec) {
+    assert(rec);
+
+    if (rec->list_bytes != sizeof(List<T>))
+        return false;
+
+    if (rec->data_bytes == 0)
+        return true;
+
+    List<T> list = {};
+    memcpy(&list, list_dump_record_list_(rec), sizeof(List<T>));
+
+    const list_idx_t capacity = list.capacity;
+
+    // every node takes at least one byte, so list_data_size doesn't overflow
+    if (capacity <= 0 || (size_t)capacity > rec->data_bytes ||
+        list_data_size<T>((size_t)capacity) != rec->data_bytes)
+        return false;
+
+    return 0 <= list.free_watermark && list.free_watermark <= capacity &&
+           0 <= list.linear_offset  && list.linear_offset  <  capacity &&
+           0 <= list.linear_prefix  && list.linear_prefix  <  capacity;
+}
+
+/**
+ * @brief Checks record of any element type
+ *
+ * @param rec
+ * @return true
+ * @return false snapshot is damaged or has unknown element type
+ */
+static bool list_dump_record_is_valid_(ListDumpRecord* rec) {
+    assert(rec);
+
+    int type = 0;
+
+    #define LIST_DUMP_RING_VALIDATE_(T)   if (rec->type == type++) return list_dump_record_is_valid_typed_<T>(rec);
+
+    LIST_ELEM_TYPES(LIST_DUMP_RING_VALIDATE_)
+
+    #undef LIST_DUMP_RING_VALIDATE_
+
+    return false;
+}
+
+/**
+ * @brief Renders one snapshot with list_dump
+ *
+ * @param rec
+ * @return true success
+ * @return false snapshot is damaged
+ */
+template <typename T>
+static bool list_dump_ring_render_typed_(ListDumpRecord* rec) {
+    assert(rec);
+
+    if (!list_dump_record_is_valid_typed_<T>(rec))
+        return false;
+
+    List<T> list = {};
+    memcpy(&list, list_dump_record_list_(rec), sizeof(List<T>));
+
+    // copied pointers are not valid anymore
+    if (rec->data_bytes > 0)
+        list_data_assign(&list, list_dump_record_data_(rec), (size_t)list.capacity);
+    else
+        list_data_assign<T>(&list, nullptr, 0);
+
+    list.order_index = nullptr;
+    list.value_index = nullptr;
+    list.var_data    = rec->var_data;
+
+    list_log_printf(&list_log_file, HTML_TEXT("deferred dump #%zu of list [%p]\n"), rec->number, rec->list_ptr);
+
+    list_dump(&list, rec->call_data, rec->params);
+
+    return true;
+}
+
+/**
+ * @brief Renders one snapshot of any element type
+ *
+ * @param rec
+ * @return true success
+ * @return false snapshot is damaged
+ */
+static bool list_dump_ring_render_record_(ListDumpRecord* rec) {
+    assert(rec);
+
+    int type = 0;
+
+    #define LIST_DUMP_RING_RENDER_(T)   if (rec->type == type++) return list_dump_ring_render_typed_<T>(rec);
+
+    LIST_ELEM_TYPES(LIST_DUMP_RING_RENDER_)
+
+    #undef LIST_DUMP_RING_RENDER_
+
+    return false;
+}
+
+bool list_dump_ring_render() {
+    ListDumpRing* ring = &list_dump_ring;
+
+    if (ring->buf == nullptr || ring->is_rendering || ring->num == 0)
+        return true;
+
+    ring->is_rendering = true;
+
+    list_log_printf(&list_log_file, HTML_TEXT("deferred dumps: %zu stored, %zu overwritten, %zu too big\n"),
+                    ring->num, ring->overwritten, ring->dropped);
+
+    bool res = true;
+    size_t offset = ring->begin;
+
+    for (size_t i = 0; i < ring->num; i++) {
+        if (!list_dump_ring_render_record_((ListDumpRecord*)(ring->buf + offset))) {
+            list_log_printf(&list_log_file, HTML_TEXT(HTML_RED("damaged snapshot\n")));
+            res = false;
+        }
+
+        offset = list_dump_ring_next_(ring, offset);
+    }
+
+    ring->begin = 0;
+    ring->end   = 0;
+    ring->num   = 0;
+    ring->is_wrapped = false;
+
+    ring->overwritten = 0;
+    ring->dropped     = 0;
+
+    ring->is_rendering = false;
+
+    return res;
+}
+
+/**
+ * @brief Returns strings of call_data and var_data in order they are saved
+ *
+ * @param rec
+ * @param strings returnable value
+ */
+static void list_dump_record_strings_get_(ListDumpRecord* rec, const char*** strings) {
+    assert(rec);
+    assert(strings);
+
+    strings[0] = &rec->call_data.name;
+    strings[1] = &rec->call_data.file;
+    strings[2] = &rec->call_data.func;
+    strings[3] = &rec->var_data.name;
+    strings[4] = &rec->var_data.file;
+    strings[5] = &rec->var_data.func;
+}
+
+static const size_t LIST_DUMP_RECORD_STRINGS_NUM = 6;
+
+#define FWRITE_(ptr_, size_)    if (fwrite(ptr_, 1, size_, file) != (size_)) { fclose(file); return false; }
+
+bool list_dump_ring_save(const char* filename) {
+    assert(filename);
+
+    const ListDumpRing* ring = &list_dump_ring;
+
+    FILE* file = fopen(filename, "wb");
+    if (file == nullptr)
+        return false;
+
+    ListDumpRingFileHeader header = {};
+
+    memcpy(header.magic, LIST_DUMP_RING_MAGIC, sizeof(header.magic));
+    header.version     = LIST_DUMP_RING_VERSION;
+    header.idx_size    = sizeof(list_idx_t);
+#ifdef LIST_SOA
+    header.is_soa      = 1;
+#endif //< #ifdef LIST_SOA
+    header.record_size = sizeof(ListDumpRecord);
+    header.num         = ring->num;
+    header.overwritten = ring->overwritten;
+    header.dropped     = ring->dropped;
+
+    FWRITE_(&header, sizeof(header));
+
+    static const char zeros[LIST_DUMP_RING_ALIGN] = {};
+
+    size_t offset = ring->begin;
+
+    for (size_t i = 0; i < ring->num; i++) {
+        ListDumpRecord rec = *(ListDumpRecord*)(ring->buf + offset);
+
+        const char** strings[LIST_DUMP_RECORD_STRINGS_NUM] = {};
+        list_dump_record_strings_get_(&rec, strings);
+
+        // strings are saved after data, because their pointers are valid only in this process
+        rec.strings_bytes = 0;
+        for (size_t str_i = 0; str_i < LIST_DUMP_RECORD_STRINGS_NUM; str_i++)
+            rec.strings_bytes += strlen(*strings[str_i]) + 1;
+
+        rec.bytes = list_dump_record_size_(rec.list_bytes, rec.data_bytes, rec.strings_bytes);
+
+        const char* src = ring->buf + offset;
+
+        FWRITE_(&rec, sizeof(rec));
+        FWRITE_(zeros, list_dump_ring_align_(sizeof(rec)) - sizeof(rec));
+        FWRITE_(src + list_dump_ring_align_(sizeof(rec)),
+                list_dump_ring_align_(rec.list_bytes) + list_dump_ring_align_(rec.data_bytes));
+
+        for (size_t str_i = 0; str_i < LIST_DUMP_RECORD_STRINGS_NUM; str_i++)
+            FWRITE_(*strings[str_i], strlen(*strings[str_i]) + 1);
+
+        FWRITE_(zeros, list_dump_ring_align_(rec.strings_bytes) - rec.strings_bytes);
+
+        offset = list_dump_ring_next_(ring, offset);
+    }
+
+    if (fclose(file) != 0)
+        return false;
+
+    return true;
+}
+#undef FWRITE_
+
+#define FREAD_(ptr_, size_)     if (fread(ptr_, 1, size_, file) != (size_)) { fclose(file); return false; }
+
+bool list_dump_ring_load(const char* filename) {
+    assert(filename);
+
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr)
+        return false;
+
+    ListDumpRingFileHeader header = {};
+    FREAD_(&header, sizeof(header));
+
+    if (memcmp(header.magic, LIST_DUMP_RING_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != LIST_DUMP_RING_VERSION || header.idx_size != sizeof(list_idx_t) ||
+#ifdef LIST_SOA
+        header.is_soa != 1 ||
+#else //< #ifndef LIST_SOA
+        header.is_soa != 0 ||
+#endif //< #ifdef LIST_SOA
+        header.record_size != sizeof(ListDumpRecord)) {
+
+        fprintf(stderr, "%s was saved by list with other build options\n", filename);
+        fclose(file);
+        return false;
+    }
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        fclose(file);
+        return false;
+    }
+
+    const long file_size = ftell(file);
+
+    if (file_size < 0 || fseek(file, (long)sizeof(header), SEEK_SET) != 0 ||
+        !list_dump_ring_start((size_t)file_size)) {
+        fclose(file);
+        return false;
+    }
+
+    for (uint64_t i = 0; i < header.num; i++) {
+        ListDumpRecord rec = {};
+        FREAD_(&rec, sizeof(rec));
+
+        // parts sizes are limited by file size first, so record size doesn't overflow
+        if (rec.list_bytes > (size_t)file_size || rec.data_bytes > (size_t)file_size ||
+            rec.strings_bytes > (size_t)file_size ||
+            rec.bytes != list_dump_record_size_(rec.list_bytes, rec.data_bytes, rec.strings_bytes) ||
+            rec.strings_bytes < LIST_DUMP_RECORD_STRINGS_NUM) {
+            fclose(file);
+            return false;
+        }
+
+        ListDumpRecord* loaded = list_dump_ring_reserve_(rec.bytes);
+
+        if (loaded == nullptr) {
+            fclose(file);
+            return false;
+        }
+
+        FREAD_((char*)loaded + sizeof(rec), rec.bytes - sizeof(rec));
+
+        *loaded = rec;
+
+        if (!list_dump_record_is_valid_(loaded)) {
+            fclose(file);
+            return false;
+        }
+
+        // strings point to loaded record now
+        char* str = list_dump_record_strings_(loaded);
+        char* strings_end = str + loaded->strings_bytes - 1;
+
+        *strings_end = '\0';
+
+        const char** strings[LIST_DUMP_RECORD_STRINGS_NUM] = {};
+        list_dump_record_strings_get_(loaded, strings);
+
+        for (size_t str_i = 0; str_i < LIST_DUMP_RECORD_STRINGS_NUM; str_i++) {
+            *strings[str_i] = str;
+
+            str = MIN(str + strlen(str) + 1, strings_end);
+        }
+
+        list_dump_ring.pushed = (size_t)rec.number + 1;
+    }
+
+    list_dump_ring.overwritten = (size_t)header.overwritten;
+    list_dump_ring.dropped     = (size_t)header.dropped;
+
+    fclose(file);
+    return true;
+}
+#undef FREAD_
+
+void list_dump_ring_stop() {
+    FREE(list_dump_ring.buf);
+
+    list_dump_ring = {};
+}
+
+#define LIST_DUMP_RING_INSTANTIATE_(T)                                                                  \
+    template bool list_dump_ring_push(const List<T>* list, const VarCodeData call_data,                 \
+                                      const ListDumpParams params);
+
+LIST_ELEM_TYPES(LIST_DUMP_RING_INSTANTIATE_)
+
+#undef LIST_DUMP_RING_INSTANTIATE_
+
+#endif //< #ifndef NDEBUG
@@ -0,0 +1,134 @@
+#ifndef LIST_ELEM_TRAITS_H_
+#define LIST_ELEM_TRAITS_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <type_traits>
+
+/**
+ * @brief Compile-time element traits (poison value, formatting, comparison and hashing)
+ *
+ * @attention Specialise it for every type List is used with and add the type to LIST_ELEM_TYPES
+ *
+ * @tparam T element type
+ */
+template <typename T>
+struct ListElemTraits;
+
+/**
+ * @brief Mixes bits of integer key (splitmix64 finalizer), so close keys get far hashes
+ *
+ * @param x
+ * @return uint64_t
+ */
+inline uint64_t list_hash_mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+
+    return x;
+}
+
+template <>
+struct ListElemTraits<int> {
+    static constexpr int POISON = __INT_MAX__ - 13;     //< poison value
+
+    static bool equal(const int a, const int b) { return a == b; }
+
+    static uint64_t hash(const int elem) { return list_hash_mix((uint64_t)elem); }
+
+    static int print(char* buf, const size_t len, const int elem) {
+        return snprintf(buf, len, "%d", elem);
+    }
+};
+
+template <>
+struct ListElemTraits<long> {
+    static constexpr long POISON = __LONG_MAX__ - 13;   //< poison value
+
+    static bool equal(const long a, const long b) { return a == b; }
+
+    static uint64_t hash(const long elem) { return list_hash_mix((uint64_t)elem); }
+
+    static int print(char* buf, const size_t len, const long elem) {
+        return snprintf(buf, len, "%ld", elem);
+    }
+};
+
+template <>
+struct ListElemTraits<double> {
+    static constexpr double POISON = -__DBL_MAX__;      //< poison value
+
+    // -Wfloat-equal friendly exact comparison. NaN isn't equal to anything
+    static bool equal(const double a, const double b) { return a <= b && a >= b; }
+
+    static uint64_t hash(const double elem) {
+        // 0.0 and -0.0 are equal, so they must have one hash. NaNs with any payload get one hash too
+        const double key = isnan(elem) ? NAN : equal(elem, 0) ? 0 : elem;
+
+        uint64_t bits = 0;
+        memcpy(&bits, &key, sizeof(bits));
+
+        return list_hash_mix(bits);
+    }
+
+    static int print(char* buf, const size_t len, const double elem) {
+        return snprintf(buf, len, "%lg", elem);
+    }
+};
+
+template <>
+struct ListElemTraits<long double> {
+    static constexpr long double POISON = -__LDBL_MAX__; //< poison value
+
+    // -Wfloat-equal friendly exact comparison. NaN isn't equal to anything
+    static bool equal(const long double a, const long double b) { return a <= b && a >= b; }
+
+    // long double has padding bytes, so equal values are hashed through double
+    static uint64_t hash(const long double elem) { return ListElemTraits<double>::hash((double)elem); }
+
+    static int print(char* buf, const size_t len, const long double elem) {
+        return snprintf(buf, len, "%Lg", elem);
+    }
+};
+
+/**
+ * @brief Max length of element text representation (used in dumps)
+ */
+const size_t LIST_ELEM_MAX_PRINT_LEN = 64;
+
+/**
+ * @brief X-macro with all element types list functions are instantiated for
+ *
+ * @param X macro taking one type argument
+ */
+#define LIST_ELEM_TYPES(X)  \
+            X(int)          \
+            X(long)         \
+            X(double)       \
+            X(long double)
+
+/**
+ * @brief Returns position of T in LIST_ELEM_TYPES. It tags element type in binary files
+ *
+ * @tparam T element type
+ * @return int -1 if T is not in LIST_ELEM_TYPES
+ */
+template <typename T>
+inline int list_elem_type_id() {
+    int type = 0;
+
+    #define LIST_ELEM_TYPE_ID_(U)   if (std::is_same<T, U>::value) return type; type++;
+
+    LIST_ELEM_TYPES(LIST_ELEM_TYPE_ID_)
+
+    #undef LIST_ELEM_TYPE_ID_
+
+    return -1;
+}
+
+#endif //< #ifndef LIST_ELEM_TRAITS_H_
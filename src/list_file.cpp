@@ -0,0 +1,664 @@
+#include "list_file.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif //< #ifndef _WIN32
+
+#include "list_log/list_log.h"
+
+extern ListLogFileData list_log_file;
+
+#define CHECK_AND_RETURN(clause_, error_, ...)  if (clause_) {          \
+                                                    res |= error_;      \
+                                                    LIST_OK(list, res); \
+                                                    __VA_ARGS__;        \
+                                                    return res;         \
+                                                }
+
+static const char     LIST_FILE_MAGIC[8]    = "LISTBIN";
+static const uint32_t LIST_FILE_VERSION     = 3;
+static const size_t   LIST_FILE_DATA_OFFSET = 4096;     //< data block starts on page boundary
+
+/**
+ * @brief Saved list header. Numbers are stored in native byte order
+ */
+struct ListFileHeader {
+    char magic[sizeof(LIST_FILE_MAGIC)] = {};
+    uint32_t version = 0;
+
+    // file is loaded only by list with the same build options and element type
+    uint32_t idx_size = 0;
+    uint32_t is_soa = 0;
+    int32_t  elem_type = -1;
+    uint32_t elem_size = 0;
+
+    uint32_t data_offset = 0;
+
+    int64_t capacity       = 0;
+    int64_t size           = 0;
+    int64_t free_head      = 0;
+    int64_t linear_prefix  = 0;
+    int64_t free_watermark = 0;
+    int64_t linear_offset  = 0;
+
+    uint32_t is_linear = 0;
+};
+
+static_assert(sizeof(ListFileHeader) <= LIST_FILE_DATA_OFFSET, "Header doesn't fit in one page");
+
+/**
+ * @brief Returns header with list fields
+ *
+ * @param list
+ * @return ListFileHeader
+ */
+template <typename T>
+static ListFileHeader list_file_header_(const List<T>* list) {
+    assert(list);
+
+    ListFileHeader header = {};
+
+    memcpy(header.magic, LIST_FILE_MAGIC, sizeof(header.magic));
+    header.version     = LIST_FILE_VERSION;
+
+    header.idx_size    = sizeof(list_idx_t);
+#ifdef LIST_SOA
+    header.is_soa      = 1;
+#endif //< #ifdef LIST_SOA
+    header.elem_type   = list_elem_type_id<T>();
+    header.elem_size   = sizeof(T);
+
+    header.data_offset = LIST_FILE_DATA_OFFSET;
+
+    header.capacity      = list->capacity;
+    header.size          = list->size;
+    header.free_head     = list->free_head;
+    header.linear_prefix = list->linear_prefix;
+    header.is_linear     = list->is_linear;
+
+    header.free_watermark = list->free_watermark;
+    header.linear_offset  = list->linear_offset;
+
+    return header;
+}
+
+/**
+ * @brief Checks header fields, that list_verify doesn't check (format, build options and
+ *        data block size), and ranges of list fields. Node links aren't checked, that is
+ *        list_verify job
+ *
+ * @param list list with expected build options and element type
+ * @param header
+ * @param file_size
+ * @return true header is valid
+ * @return false
+ */
+template <typename T>
+static bool list_file_header_is_valid_(const List<T>* list, const ListFileHeader* header,
+                                       const size_t file_size) {
+    assert(list);
+    assert(header);
+
+    const ListFileHeader expected = list_file_header_(list);
+
+    if (memcmp(header->magic, expected.magic, sizeof(header->magic)) != 0 ||
+        header->version     != expected.version   ||
+        header->idx_size    != expected.idx_size  ||
+        header->is_soa      != expected.is_soa    ||
+        header->elem_type   != expected.elem_type ||
+        header->elem_size   != expected.elem_size ||
+        header->data_offset != expected.data_offset)
+        return false;
+
+    // capacity is limited by file size first, so list_data_size doesn't overflow
+    const size_t node_size = 2 * sizeof(list_idx_t) + sizeof(T);
+
+    if (header->capacity <= 0 || header->capacity >= LIST_IDX_MAX ||
+        (size_t)header->capacity > (file_size - LIST_FILE_DATA_OFFSET) / node_size ||
+        file_size - LIST_FILE_DATA_OFFSET < list_data_size<T>((size_t)header->capacity))
+        return false;
+
+    return 0 <= header->size           && header->size < header->capacity              &&
+           0 <  header->free_watermark && header->free_watermark <= header->capacity   &&
+           0 <= header->free_head      && header->free_head < header->free_watermark   &&
+           0 <= header->linear_prefix  && header->linear_prefix <= header->size        &&
+           0 <= header->linear_offset  && header->linear_offset < MAX(header->capacity - 1, 1) &&
+           header->is_linear == (header->linear_prefix == header->size);
+}
+
+/**
+ * @brief Writes used bytes of data block array and zeros instead of the rest of it
+ *
+ * @param file
+ * @param array
+ * @param used_bytes initialised part of array
+ * @param array_bytes
+ * @return true success
+ * @return false write error
+ */
+static bool list_file_write_array_(FILE* file, const void* array, const size_t used_bytes,
+                                   const size_t array_bytes) {
+    assert(file);
+    assert(used_bytes <= array_bytes);
+
+    static const char zeros[LIST_FILE_DATA_OFFSET] = {};
+
+    if (used_bytes > 0 && fwrite(array, used_bytes, 1, file) != 1)
+        return false;
+
+    for (size_t written = used_bytes; written < array_bytes; written += sizeof(zeros)) {
+        const size_t chunk = MIN(sizeof(zeros), array_bytes - written);
+
+        if (fwrite(zeros, chunk, 1, file) != 1)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes data block. Slots over free_watermark aren't initialised, so zeros are written
+ *        instead of them (and instead of padding before elem array of SoA layout)
+ *
+ * @param list
+ * @param file
+ * @return true success
+ * @return false write error
+ */
+template <typename T>
+static bool list_file_write_data_(const List<T>* list, FILE* file) {
+    assert(list);
+    assert(file);
+
+    const size_t capacity = (size_t)list->capacity;
+    const size_t used     = (size_t)list->free_watermark;
+
+#ifdef LIST_SOA
+    const size_t idx_bytes = sizeof(list_idx_t);
+
+    return list_file_write_array_(file, list->next, used * idx_bytes, capacity * idx_bytes) &&
+           list_file_write_array_(file, list->prev, used * idx_bytes,
+                                  list_data_elem_offset<T>(capacity) - capacity * idx_bytes) &&
+           list_file_write_array_(file, list->elem, used * sizeof(T), capacity * sizeof(T));
+#else //< #ifndef LIST_SOA
+    return list_file_write_array_(file, list->arr, used * sizeof(ListNode<T>), capacity * sizeof(ListNode<T>));
+#endif //< #ifdef LIST_SOA
+}
+
+template <typename T>
+int list_save(const List<T>* list, const char* path) {
+    assert(path);
+
+    int res = LIST_ASSERT(list);
+
+    FILE* file = fopen(path, "wb");
+
+    CHECK_AND_RETURN(file == nullptr, list->FILE_IO_ERR);
+
+    const ListFileHeader header = list_file_header_(list);
+    static const char zeros[LIST_FILE_DATA_OFFSET] = {};
+
+    CHECK_AND_RETURN(fwrite(&header, sizeof(header), 1, file) != 1 ||
+                     fwrite(zeros, LIST_FILE_DATA_OFFSET - sizeof(header), 1, file) != 1 ||
+                     !list_file_write_data_(list, file), list->FILE_IO_ERR, fclose(file));
+
+    CHECK_AND_RETURN(fclose(file) != 0, list->FILE_IO_ERR);
+
+    return res;
+}
+
+#ifndef _WIN32
+
+/**
+ * @brief Makes list uninitialised after failed load
+ *
+ * @param list
+ */
+template <typename T>
+static void list_load_reset_(List<T>* list) {
+    assert(list);
+
+    list_mapping_free(&list->mapping);
+    list_data_assign<T>(list, nullptr, 0);
+
+    list->capacity  = list->UNITIALISED_VAL;
+    list->free_head = list->UNITIALISED_VAL;
+    list->size      = list->UNITIALISED_VAL;
+    list->is_linear = false;
+    list->linear_prefix  = list->UNITIALISED_VAL;
+    list->linear_offset  = 0;
+    list->free_watermark = list->UNITIALISED_VAL;
+}
+
+template <typename T>
+int list_load_mmap(List<T>* list, const char* path, const bool is_shared, const bool verify) {
+    assert(list);
+    assert(path);
+
+    int res = list->OK;
+
+    CHECK_AND_RETURN(list_is_initialised(list), list->ALREADY_INITIALISED);
+
+    const int fd = open(path, is_shared ? O_RDWR : O_RDONLY);
+
+    CHECK_AND_RETURN(fd == -1, list->FILE_IO_ERR);
+
+    struct stat file_stat = {};
+
+    CHECK_AND_RETURN(fstat(fd, &file_stat) != 0, list->FILE_IO_ERR, close(fd));
+    CHECK_AND_RETURN((size_t)file_stat.st_size < LIST_FILE_DATA_OFFSET, list->INVALID_FILE, close(fd));
+
+    const size_t file_size = (size_t)file_stat.st_size;
+
+    // private mapping is writable too: changed pages are copied
+    void* addr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, is_shared ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+
+    CHECK_AND_RETURN(addr == MAP_FAILED, list->FILE_IO_ERR, close(fd));
+
+    if (!is_shared)
+        close(fd);
+
+    ListMapping mapping = {};
+
+    mapping.kind = is_shared ? ListMapping::FILE_SHARED : ListMapping::FILE_PRIVATE;
+    mapping.addr = addr;
+    mapping.size = file_size;
+    mapping.fd   = is_shared ? fd : -1;
+
+    const ListFileHeader* header = (const ListFileHeader*)addr;
+
+    CHECK_AND_RETURN(!list_file_header_is_valid_(list, header, file_size), list->INVALID_FILE,
+                     list_mapping_free(&mapping));
+
+    list->mapping = mapping;
+
+    list->capacity      = (list_idx_t)header->capacity;
+    list->size          = (list_idx_t)header->size;
+    list->free_head     = (list_idx_t)header->free_head;
+    list->linear_prefix = (list_idx_t)header->linear_prefix;
+    list->is_linear     = header->is_linear;
+
+    list->free_watermark = (list_idx_t)header->free_watermark;
+    list->linear_offset  = (list_idx_t)header->linear_offset;
+
+    list_data_assign(list, (char*)addr + LIST_FILE_DATA_OFFSET, (size_t)list->capacity);
+
+    if (verify) {
+        res |= list_verify(list);
+
+        CHECK_AND_RETURN(res != list->OK, list->INVALID_FILE, list_load_reset_(list));
+    }
+
+    return res;
+}
+
+template <typename T>
+int list_sync(List<T>* list) {
+    int res = LIST_ASSERT(list);
+
+    if (list->mapping.kind != ListMapping::FILE_SHARED)
+        return res;
+
+    const ListFileHeader header = list_file_header_(list);
+
+    memcpy(list->mapping.addr, &header, sizeof(header));
+
+    CHECK_AND_RETURN(msync(list->mapping.addr, list->mapping.size, MS_SYNC) != 0, list->FILE_IO_ERR);
+
+    return res;
+}
+
+static const size_t LIST_MAPPING_HUGE_PAGE_SIZE = 2 << 20;
+
+/**
+ * @brief Rounds size up to granularity
+ *
+ * @param size
+ * @param granularity
+ * @return size_t
+ */
+static size_t list_mapping_round_up_(const size_t size, const size_t granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+/**
+ * @brief Returns anonymous mapping size granularity (page or huge page size)
+ *
+ * @param mapping
+ * @return size_t
+ */
+static size_t list_mapping_granularity_(const ListMapping* mapping) {
+    assert(mapping);
+
+    return mapping->huge_pages ? LIST_MAPPING_HUGE_PAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Maps anonymous memory aligned to align
+ *
+ * @param size
+ * @param align
+ * @return void* MAP_FAILED on failure
+ */
+static void* list_mapping_map_aligned_(const size_t size, const size_t align) {
+    char* addr = (char*)mmap(nullptr, size + align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (addr == MAP_FAILED)
+        return MAP_FAILED;
+
+    char* aligned = addr + (align - (uintptr_t)addr % align) % align;
+
+    // excess pages before and after aligned part are unmapped
+    if (aligned != addr)
+        munmap(addr, (size_t)(aligned - addr));
+
+    munmap(aligned + size, (size_t)(addr + align - aligned));
+
+    return aligned;
+}
+
+/**
+ * @brief Maps zeroed anonymous memory for mapping
+ *
+ * @param mapping
+ * @param size
+ * @return void* MAP_FAILED on failure
+ */
+static void* list_mapping_map_anon_(const ListMapping* mapping, const size_t size) {
+    assert(mapping);
+
+    if (!mapping->huge_pages)
+        return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    void* addr = list_mapping_map_aligned_(size, LIST_MAPPING_HUGE_PAGE_SIZE);
+
+#ifdef MADV_HUGEPAGE
+    // huge pages are only a hint, so errors are ignored
+    if (addr != MAP_FAILED)
+        madvise(addr, size, MADV_HUGEPAGE);
+#endif //< #ifdef MADV_HUGEPAGE
+
+    return addr;
+}
+
+/**
+ * @brief Moves mapping to new mapping of new_size bytes. On Linux pages are remapped, not copied
+ *
+ * @param mapping
+ * @param new_size
+ * @return void* new mapping address. MAP_FAILED on failure (old mapping stays valid)
+ */
+static void* list_mapping_remap_(const ListMapping* mapping, const size_t new_size) {
+    assert(mapping);
+
+#ifdef __linux__
+    if (mapping->kind == ListMapping::ANON && mapping->huge_pages) {
+        // aligned place is reserved first, mremap replaces it
+        void* place = list_mapping_map_aligned_(new_size, LIST_MAPPING_HUGE_PAGE_SIZE);
+
+        if (place == MAP_FAILED)
+            return MAP_FAILED;
+
+        void* addr = mremap(mapping->addr, mapping->size, new_size, MREMAP_MAYMOVE | MREMAP_FIXED, place);
+
+        if (addr == MAP_FAILED) {
+            munmap(place, new_size);
+            return MAP_FAILED;
+        }
+
+#ifdef MADV_HUGEPAGE
+        madvise(addr, new_size, MADV_HUGEPAGE);
+#endif //< #ifdef MADV_HUGEPAGE
+
+        return addr;
+    }
+
+    return mremap(mapping->addr, mapping->size, new_size, MREMAP_MAYMOVE);
+
+#else //< #ifndef __linux__
+
+    void* addr = mapping->kind == ListMapping::ANON ?
+                 list_mapping_map_anon_(mapping, new_size) :
+                 mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, mapping->fd, 0);
+
+    if (addr == MAP_FAILED)
+        return MAP_FAILED;
+
+    // file pages are shared by both mappings, so only anonymous pages are copied
+    if (mapping->kind == ListMapping::ANON)
+        memcpy(addr, mapping->addr, MIN(mapping->size, new_size));
+
+    munmap(mapping->addr, mapping->size);
+
+    return addr;
+#endif //< #ifdef __linux__
+}
+
+/**
+ * @brief Releases anonymous mapping bytes [from, to). They are zero, when they are used again
+ *
+ * @param mapping
+ * @param from
+ * @param to
+ */
+static void list_mapping_release_(const ListMapping* mapping, const size_t from, const size_t to) {
+    assert(mapping);
+    assert(from <= to);
+
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t first_page = list_mapping_round_up_(from, page);
+
+    // only whole pages are released, the rest of the first page is zeroed
+    memset((char*)mapping->addr + from, 0, MIN(first_page, to) - from);
+
+    if (first_page < to)
+        madvise((char*)mapping->addr + first_page, list_mapping_round_up_(to, page) - first_page, MADV_DONTNEED);
+}
+
+void* list_mapping_alloc(ListMapping* mapping, const size_t size) {
+    assert(mapping);
+    assert(mapping->addr == nullptr);
+
+    if (mapping->kind == ListMapping::ANON) {
+        const size_t mapping_size = list_mapping_round_up_(size, list_mapping_granularity_(mapping));
+
+        void* addr = list_mapping_map_anon_(mapping, mapping_size);
+
+        if (addr == MAP_FAILED)
+            return nullptr;
+
+        mapping->addr = addr;
+        mapping->size = mapping_size;
+
+        return addr;
+    }
+
+    assert(mapping->kind == ListMapping::FILE_SHARED);
+
+    // data block follows header page, as in list_save file
+    const size_t mapping_size = LIST_FILE_DATA_OFFSET + size;
+
+    if (ftruncate(mapping->fd, (off_t)mapping_size) != 0)
+        return nullptr;
+
+    void* addr = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, mapping->fd, 0);
+
+    if (addr == MAP_FAILED)
+        return nullptr;
+
+    mapping->addr = addr;
+    mapping->size = mapping_size;
+
+    return (char*)addr + LIST_FILE_DATA_OFFSET;
+}
+
+void* list_mapping_realloc(ListMapping* mapping, void* data, const size_t old_size, const size_t new_size) {
+    assert(mapping);
+    assert(mapping->addr);
+    assert(data);
+
+    switch (mapping->kind) {
+        case ListMapping::ANON: {
+            // mapping isn't cut, so it grows back without remapping
+            if (new_size <= mapping->size) {
+                if (new_size < old_size)
+                    list_mapping_release_(mapping, new_size, old_size);
+
+                return data;
+            }
+
+            const size_t new_mapping_size = list_mapping_round_up_(new_size, list_mapping_granularity_(mapping));
+
+            void* addr = list_mapping_remap_(mapping, new_mapping_size);
+
+            if (addr == MAP_FAILED)
+                return nullptr;
+
+            mapping->addr = addr;
+            mapping->size = new_mapping_size;
+
+            return addr;
+        }
+
+        case ListMapping::FILE_SHARED: {
+            const size_t offset = (size_t)((char*)data - (char*)mapping->addr);
+            const size_t new_mapping_size = offset + new_size;
+
+            // file is enlarged before remapping and cut after it, so every mapped page is backed by file
+            if (new_mapping_size > mapping->size && ftruncate(mapping->fd, (off_t)new_mapping_size) != 0)
+                return nullptr;
+
+            void* addr = list_mapping_remap_(mapping, new_mapping_size);
+
+            if (addr == MAP_FAILED)
+                return nullptr;
+
+            if (new_mapping_size < mapping->size && ftruncate(mapping->fd, (off_t)new_mapping_size) != 0)
+                perror("Error cutting list file");
+
+            mapping->addr = addr;
+            mapping->size = new_mapping_size;
+
+            return (char*)addr + offset;
+        }
+
+        case ListMapping::NONE:
+        case ListMapping::FILE_PRIVATE:
+        default:
+            assert(0 && "Data block isn't mapped or can't be resized in mapping");
+            return nullptr;
+    }
+}
+
+void list_mapping_free(ListMapping* mapping) {
+    assert(mapping);
+
+    if (mapping->addr != nullptr)
+        munmap(mapping->addr, mapping->size);
+
+    if (mapping->fd != -1)
+        close(mapping->fd);
+
+    *mapping = {};
+}
+
+template <typename T>
+int list_ctor_mmap(List<T>* list, size_t init_capacity, const char* path, const bool huge_pages) {
+    assert(list);
+
+    int res = list->OK;
+
+    CHECK_AND_RETURN(list_is_initialised(list), list->ALREADY_INITIALISED);
+
+    ListMapping mapping = {};
+
+    mapping.kind       = path == nullptr ? ListMapping::ANON : ListMapping::FILE_SHARED;
+    mapping.huge_pages = path == nullptr && huge_pages;
+
+    if (path != nullptr) {
+        mapping.fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        CHECK_AND_RETURN(mapping.fd == -1, list->FILE_IO_ERR);
+    }
+
+    // list_ctor allocates data block in mapping of this kind
+    list->mapping = mapping;
+
+    res |= list_ctor(list, init_capacity);
+
+    if (res != list->OK) {
+        list_mapping_free(&list->mapping);
+        return res;
+    }
+
+    return res | list_sync(list);
+}
+
+#else //< #ifdef _WIN32
+
+template <typename T>
+int list_load_mmap(List<T>* list, const char* path, const bool is_shared, const bool verify) {
+    assert(list);
+    assert(path);
+
+    (void) is_shared;
+    (void) verify;
+
+    return list->FILE_IO_ERR;
+}
+
+template <typename T>
+int list_sync(List<T>* list) {
+    return LIST_VERIFY(list);
+}
+
+template <typename T>
+int list_ctor_mmap(List<T>* list, size_t init_capacity, const char* path, const bool huge_pages) {
+    assert(list);
+
+    (void) init_capacity;
+    (void) path;
+    (void) huge_pages;
+
+    return list->FILE_IO_ERR;
+}
+
+void* list_mapping_alloc(ListMapping* mapping, const size_t size) {
+    (void) mapping;
+    (void) size;
+
+    return nullptr;
+}
+
+void* list_mapping_realloc(ListMapping* mapping, void* data, const size_t old_size, const size_t new_size) {
+    (void) mapping;
+    (void) data;
+    (void) old_size;
+    (void) new_size;
+
+    return nullptr;
+}
+
+void list_mapping_free(ListMapping* mapping) {
+    assert(mapping);
+
+    *mapping = {};
+}
+
+#endif //< #ifndef _WIN32
+
+#undef CHECK_AND_RETURN
+
+#define LIST_FILE_INSTANTIATE_(T)                                                                       \
+    template int list_ctor_mmap(List<T>* list, size_t init_capacity, const char* path,                 \
+                                const bool huge_pages);                                                 \
+    template int list_save(const List<T>* list, const char* path);                                      \
+    template int list_load_mmap(List<T>* list, const char* path, const bool is_shared, const bool verify); \
+    template int list_sync(List<T>* list);
+
+LIST_ELEM_TYPES(LIST_FILE_INSTANTIATE_)
+
+#undef LIST_FILE_INSTANTIATE_
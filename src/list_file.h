@@ -0,0 +1,34 @@
+#ifndef LIST_FILE_H_
+#define LIST_FILE_H_
+
+#include "list.h"
+
+/**
+ * @brief Creates mapping of kind and fd set by list_ctor_mmap
+ *
+ * @param mapping
+ * @param size data block size
+ * @return void* zeroed data block. nullptr on failure
+ */
+void* list_mapping_alloc(ListMapping* mapping, const size_t size);
+
+/**
+ * @brief Resizes data block, that is part of mapping. Anonymous mapping is remapped, FILE_SHARED
+ *        file is resized and remapped. FILE_PRIVATE data is moved out of mapping by caller
+ *
+ * @param mapping
+ * @param data data block
+ * @param old_size
+ * @param new_size
+ * @return void* new data block. nullptr on failure (old block stays valid)
+ */
+void* list_mapping_realloc(ListMapping* mapping, void* data, const size_t old_size, const size_t new_size);
+
+/**
+ * @brief Unmaps mapping and closes its file
+ *
+ * @param mapping
+ */
+void list_mapping_free(ListMapping* mapping);
+
+#endif //< #ifndef LIST_FILE_H_
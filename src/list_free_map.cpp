@@ -0,0 +1,156 @@
+#include "list_free_map.h"
+
+#include <string.h>
+
+/**
+ * @brief Builds map from scratch in O(free_watermark)
+ *
+ * @param list
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_free_map_rebuild_(const List<T>* list) {
+    assert(list);
+
+    ListFreeMap* map = list->free_map;
+    assert(map);
+
+    const list_idx_t words_num = (list->capacity + 63) / 64;
+
+    if (words_num != map->words_num) {
+        uint64_t* words = (uint64_t*)realloc(map->words, (size_t)words_num * sizeof(uint64_t));
+
+        if (words == nullptr) {
+            map->is_valid = false;
+            return false;
+        }
+
+        map->words     = words;
+        map->words_num = words_num;
+    }
+
+    memset(map->words, 0, (size_t)map->words_num * sizeof(uint64_t));
+
+    for (list_idx_t phys_i = 1; phys_i < list->free_watermark; phys_i++) {
+        if (list_is_free(list, phys_i))
+            map->words[phys_i / 64] |= (uint64_t)1 << (phys_i % 64);
+    }
+
+    map->is_valid = true;
+    return true;
+}
+
+template <typename T>
+int list_free_map_enable(List<T>* list) {
+    assert(list);
+
+    if (list->free_map != nullptr)
+        return list->OK;
+
+    list->free_map = (ListFreeMap*)calloc(1, sizeof(ListFreeMap));
+
+    if (list->free_map == nullptr)
+        return list->ALLOC_ERR;
+
+    return list->OK;
+}
+
+template <typename T>
+void list_free_map_disable(List<T>* list) {
+    assert(list);
+
+    if (list->free_map == nullptr)
+        return;
+
+    free(list->free_map->words);
+
+    FREE(list->free_map);
+}
+
+template <typename T>
+void list_free_map_clear(const List<T>* list) {
+    assert(list);
+
+    ListFreeMap* map = list->free_map;
+
+    if (map == nullptr || !map->is_valid)
+        return;
+
+    // bits over free_watermark are never set
+    const list_idx_t end = MIN((list->free_watermark + 63) / 64, map->words_num);
+
+    memset(map->words, 0, (size_t)end * sizeof(uint64_t));
+}
+
+template <typename T>
+list_idx_t list_free_map_nearest(const List<T>* list, const list_idx_t position) {
+    assert(list);
+    assert(0 <= position && position < list->free_watermark);
+
+    ListFreeMap* map = list->free_map;
+
+    if (map == nullptr || (!map->is_valid && !list_free_map_rebuild_(list)))
+        return 0;
+
+    const list_idx_t target = position + 1;
+    const list_idx_t radius = map->SEARCH_WORDS * 64;
+
+    // slots over free_watermark aren't in map, but free_watermark itself is taken in O(1)
+    list_idx_t right = 0;
+    if (list->free_watermark < list->capacity && list->free_watermark - target <= radius)
+        right = list->free_watermark;
+
+    // bits over free_watermark are never set, so words are scanned up to it
+    const list_idx_t last_word = MIN(target / 64 + map->SEARCH_WORDS, (list->free_watermark - 1) / 64);
+
+    for (list_idx_t word_i = target / 64; word_i <= last_word; word_i++) {
+        uint64_t word = map->words[word_i];
+
+        if (word_i == target / 64)
+            word &= ~(uint64_t)0 << (target % 64);
+
+        if (word != 0) {
+            right = word_i * 64 + __builtin_ctzll(word);
+            break;
+        }
+    }
+
+    if (right == target)
+        return right;
+
+    // slots before position are scanned only while they may be nearer than right one
+    list_idx_t left = 0;
+
+    const list_idx_t first_word = MAX(position / 64 - map->SEARCH_WORDS, 0);
+
+    for (list_idx_t word_i = position / 64; word_i >= first_word; word_i--) {
+        if (right != 0 && target - (word_i * 64 + 63) >= right - target)
+            break;
+
+        uint64_t word = map->words[word_i];
+
+        if (word_i == position / 64 && position % 64 != 63)
+            word &= ((uint64_t)1 << (position % 64 + 1)) - 1;
+
+        if (word != 0) {
+            left = word_i * 64 + 63 - __builtin_clzll(word);
+            break;
+        }
+    }
+
+    if (left != 0 && (right == 0 || target - left < right - target))
+        return left;
+
+    return right;
+}
+
+#define LIST_FREE_MAP_INSTANTIATE_(T)                                                               \
+    template int        list_free_map_enable(List<T>* list);                                        \
+    template void       list_free_map_disable(List<T>* list);                                       \
+    template void       list_free_map_clear(const List<T>* list);                                   \
+    template list_idx_t list_free_map_nearest(const List<T>* list, const list_idx_t position);
+
+LIST_ELEM_TYPES(LIST_FREE_MAP_INSTANTIATE_)
+
+#undef LIST_FREE_MAP_INSTANTIATE_
@@ -0,0 +1,97 @@
+#ifndef LIST_FREE_MAP_H_
+#define LIST_FREE_MAP_H_
+
+#include "list.h"
+
+/**
+ * @brief Free slot bitmap. Bit of slot is set, if slot is in free list, so insert takes the free slot
+ *        nearest to its position instead of the last freed one. Free list itself (free_head and links
+ *        of free slots) isn't changed, map only chooses which slot is taken from it
+ *
+ * @attention It is rebuilt lazily (O(free_watermark)) on the first insert after resize
+ */
+struct ListFreeMap {
+    uint64_t*  words     = nullptr;     //< bit i % 64 of words[i / 64] is set, if slot i is in free list
+    list_idx_t words_num = 0;           //< words array length
+
+    bool is_valid = false;              //< false if map has to be rebuilt
+
+    static const list_idx_t SEARCH_WORDS = 8;   //< words scanned on each side of position
+};
+
+/**
+ * @brief Creates free slot map for list. Inserts take free slots nearest to their positions
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_free_map_enable(List<T>* list);
+
+/**
+ * @brief Destroys list free slot map. Inserts take the last freed slot again
+ *
+ * @param list
+ */
+template <typename T>
+void list_free_map_disable(List<T>* list);
+
+/**
+ * @brief Marks map to be rebuilt on next insert
+ *
+ * @param list
+ */
+template <typename T>
+inline void list_free_map_invalidate(const List<T>* list) {
+    if (list->free_map != nullptr)
+        list->free_map->is_valid = false;
+}
+
+/**
+ * @brief Marks slot, that was pushed to free list
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+inline void list_free_map_push(const List<T>* list, const list_idx_t phys_i) {
+    ListFreeMap* map = list->free_map;
+
+    if (map != nullptr && map->is_valid)
+        map->words[phys_i / 64] |= (uint64_t)1 << (phys_i % 64);
+}
+
+/**
+ * @brief Unmarks slot, that was removed from free list
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+inline void list_free_map_remove(const List<T>* list, const list_idx_t phys_i) {
+    ListFreeMap* map = list->free_map;
+
+    if (map != nullptr && map->is_valid)
+        map->words[phys_i / 64] &= ~((uint64_t)1 << (phys_i % 64));
+}
+
+/**
+ * @brief Unmarks all slots in O(free_watermark / 64). Is called when free list is dropped
+ *
+ * @param list
+ */
+template <typename T>
+void list_free_map_clear(const List<T>* list);
+
+/**
+ * @brief Finds free slot nearest to position + 1 (slots after it are preferred on equal distance).
+ *        Only SEARCH_WORDS words on each side of position are scanned, so it is O(1)
+ *
+ * @param list
+ * @param position physical index of list element or 0
+ * @return list_idx_t slot in free list or free_watermark. 0 if there is no map or no slot near position
+ */
+template <typename T>
+list_idx_t list_free_map_nearest(const List<T>* list, const list_idx_t position);
+
+#endif //< #ifndef LIST_FREE_MAP_H_
@@ -1,5 +1,9 @@
 #include "list_dot_log.h"
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif //< #ifndef _WIN32
+
 bool list_dot_log_create_img(const char* input_filename, const char* output_filename) {
     assert(input_filename);
     assert(output_filename);
@@ -21,3 +25,209 @@ bool list_dot_log_create_img(const char* input_filename, const char* output_file
 
     return true;
 }
+
+#ifndef _WIN32
+
+static const size_t LIST_DOT_LOG_MAX_FILENAME_LEN = 256;
+static const size_t LIST_DOT_LOG_QUEUE_LEN        = 256;    //< producer waits, when queue is full
+static const size_t LIST_DOT_LOG_MAX_BATCH        = 16;     //< max files rendered by one dot process
+static const size_t LIST_DOT_LOG_MAX_WORKERS      = 16;
+
+/**
+ * @brief Render queue and workers
+ */
+struct ListDotLogPool {
+    char queue[LIST_DOT_LOG_QUEUE_LEN][LIST_DOT_LOG_MAX_FILENAME_LEN] = {};
+    size_t queue_begin = 0;
+    size_t queue_size  = 0;
+
+    size_t in_progress = 0;     //< number of files taken by workers, but not rendered yet
+
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t  has_jobs  = PTHREAD_COND_INITIALIZER;   //< signaled, when job is queued or pool stops
+    pthread_cond_t  has_space = PTHREAD_COND_INITIALIZER;   //< signaled, when job is taken or done
+
+    pthread_t workers[LIST_DOT_LOG_MAX_WORKERS] = {};
+    size_t workers_num = 0;
+
+    bool is_stopping = false;
+    bool is_exit_registered = false;
+};
+
+static ListDotLogPool list_dot_log_pool = {};
+
+/**
+ * @brief Worker thread. Takes batch of queued files and renders it by one dot process
+ *
+ * @param arg unused
+ * @return void*
+ */
+static void* list_dot_log_worker_(void* arg) {
+    (void) arg;
+
+    ListDotLogPool* pool = &list_dot_log_pool;
+
+    // "dot -Tsvg -O" + " 'filename'" for every file of batch
+    static const size_t MAX_COMMAND_LEN = 16 + LIST_DOT_LOG_MAX_BATCH * (LIST_DOT_LOG_MAX_FILENAME_LEN + 3);
+    char* command = (char*)calloc(MAX_COMMAND_LEN, sizeof(char));
+
+    if (command == nullptr)
+        return nullptr;
+
+    while (true) {
+        pthread_mutex_lock(&pool->mutex);
+
+        while (pool->queue_size == 0 && !pool->is_stopping)
+            pthread_cond_wait(&pool->has_jobs, &pool->mutex);
+
+        if (pool->queue_size == 0) {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+
+        // every worker takes its share of queue, so files are rendered in parallel
+        const size_t share = pool->queue_size / pool->workers_num + 1;
+        const size_t batch = share < LIST_DOT_LOG_MAX_BATCH ? share : LIST_DOT_LOG_MAX_BATCH;
+
+        size_t len = (size_t)snprintf(command, MAX_COMMAND_LEN, "dot -Tsvg -O");
+
+        size_t taken = 0;
+        for (; taken < batch && pool->queue_size > 0; taken++) {
+            len += (size_t)snprintf(command + len, MAX_COMMAND_LEN - len, " '%s'",
+                                    pool->queue[pool->queue_begin]);
+
+            pool->queue_begin = (pool->queue_begin + 1) % LIST_DOT_LOG_QUEUE_LEN;
+            pool->queue_size--;
+        }
+
+        pool->in_progress += taken;
+
+        pthread_cond_broadcast(&pool->has_space);
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (system(command) != 0)
+            fprintf(stderr, "Error executing \"%s\"\n", command);
+
+        pthread_mutex_lock(&pool->mutex);
+
+        pool->in_progress -= taken;
+
+        pthread_cond_broadcast(&pool->has_space);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+
+    free(command);
+
+    return nullptr;
+}
+
+bool list_dot_log_start(const size_t workers_num) {
+    assert(workers_num > 0);
+
+    ListDotLogPool* pool = &list_dot_log_pool;
+
+    if (pool->workers_num > 0)
+        return true;
+
+    if (!pool->is_exit_registered) {
+        if (atexit(list_dot_log_stop) != 0)
+            return false;
+
+        pool->is_exit_registered = true;
+    }
+
+    pool->is_stopping = false;
+
+    const size_t num = workers_num < LIST_DOT_LOG_MAX_WORKERS ? workers_num : LIST_DOT_LOG_MAX_WORKERS;
+
+    for (size_t i = 0; i < num; i++) {
+        if (pthread_create(&pool->workers[i], nullptr, list_dot_log_worker_, nullptr) != 0) {
+            list_dot_log_stop();
+            return false;
+        }
+
+        pool->workers_num++;
+    }
+
+    return true;
+}
+
+bool list_dot_log_is_async() {
+    return list_dot_log_pool.workers_num > 0;
+}
+
+bool list_dot_log_queue_img(const char* input_filename) {
+    assert(input_filename);
+
+    ListDotLogPool* pool = &list_dot_log_pool;
+
+    // file names are quoted in command
+    if (pool->workers_num == 0 || strlen(input_filename) >= LIST_DOT_LOG_MAX_FILENAME_LEN ||
+        strchr(input_filename, '\'') != nullptr)
+        return false;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while (pool->queue_size == LIST_DOT_LOG_QUEUE_LEN)
+        pthread_cond_wait(&pool->has_space, &pool->mutex);
+
+    strcpy(pool->queue[(pool->queue_begin + pool->queue_size) % LIST_DOT_LOG_QUEUE_LEN], input_filename);
+    pool->queue_size++;
+
+    pthread_cond_signal(&pool->has_jobs);
+    pthread_mutex_unlock(&pool->mutex);
+
+    return true;
+}
+
+void list_dot_log_wait() {
+    ListDotLogPool* pool = &list_dot_log_pool;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while (pool->workers_num > 0 && (pool->queue_size > 0 || pool->in_progress > 0))
+        pthread_cond_wait(&pool->has_space, &pool->mutex);
+
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void list_dot_log_stop() {
+    ListDotLogPool* pool = &list_dot_log_pool;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    pool->is_stopping = true;
+
+    pthread_cond_broadcast(&pool->has_jobs);
+    pthread_mutex_unlock(&pool->mutex);
+
+    // workers render rest of queue before exit
+    for (size_t i = 0; i < pool->workers_num; i++)
+        pthread_join(pool->workers[i], nullptr);
+
+    pool->workers_num = 0;
+}
+
+#else //< #ifdef _WIN32
+
+bool list_dot_log_start(const size_t workers_num) {
+    (void) workers_num;
+
+    return false;
+}
+
+bool list_dot_log_is_async() {
+    return false;
+}
+
+bool list_dot_log_queue_img(const char* input_filename) {
+    (void) input_filename;
+
+    return false;
+}
+
+void list_dot_log_wait() {}
+
+void list_dot_log_stop() {}
+
+#endif //< #ifndef _WIN32
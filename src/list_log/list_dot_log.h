@@ -8,4 +8,43 @@
 
 bool list_dot_log_create_img(const char* input_filename, const char* output_filename);
 
+/**
+ * @brief Starts background render workers. After it list_dot_log_queue_img is used by dumps
+ *
+ * @attention Not supported on Windows (returns false, rendering stays synchronous)
+ *
+ * @param workers_num number of threads. Every one runs one dot process for batch of files
+ * @return true success
+ * @return false failure
+ */
+bool list_dot_log_start(const size_t workers_num);
+
+/**
+ * @brief Returns true if background workers are started
+ *
+ * @return true
+ * @return false
+ */
+bool list_dot_log_is_async();
+
+/**
+ * @brief Queues input_filename to be rendered by background worker. Image name is
+ *        input_filename with ".svg" suffix (dot -O naming)
+ *
+ * @param input_filename
+ * @return true success
+ * @return false failure
+ */
+bool list_dot_log_queue_img(const char* input_filename);
+
+/**
+ * @brief Waits until all queued images are rendered
+ */
+void list_dot_log_wait();
+
+/**
+ * @brief Waits until all queued images are rendered and stops workers. Is called at exit
+ */
+void list_dot_log_stop();
+
 #endif //< #ifndef LIST_DOT_LOG_H_
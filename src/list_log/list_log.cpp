@@ -1,11 +1,103 @@
 #include "list_log.h"
 
+static const size_t LIST_LOG_MAX_PERSISTENT = 16;   //< max number of persistent logs flushed at exit
+
+static ListLogFileData* list_log_persistent[LIST_LOG_MAX_PERSISTENT] = {};
+static size_t list_log_persistent_num = 0;
+
+/**
+ * @brief Closes all persistent logs (atexit handler)
+ */
+static void list_log_close_persistent_() {
+    for (size_t i = 0; i < list_log_persistent_num; i++) {
+        ListLogFileData* log_file = list_log_persistent[i];
+
+        if (log_file->file != nullptr)
+            list_log_close_file(log_file);
+
+        free(log_file->buffer);
+        log_file->buffer = nullptr;
+    }
+
+    list_log_persistent_num = 0;
+}
+
+/**
+ * @brief Registers log to be closed at exit
+ *
+ * @param log_file
+ * @return true success
+ * @return false too many persistent logs
+ */
+static bool list_log_register_persistent_(ListLogFileData* log_file) {
+    assert(log_file);
+
+    for (size_t i = 0; i < list_log_persistent_num; i++)
+        if (list_log_persistent[i] == log_file)
+            return true;
+
+    if (list_log_persistent_num >= LIST_LOG_MAX_PERSISTENT)
+        return false;
+
+    if (list_log_persistent_num == 0 && atexit(list_log_close_persistent_) != 0)
+        return false;
+
+    list_log_persistent[list_log_persistent_num++] = log_file;
+
+    return true;
+}
+
+/**
+ * @brief Opens persistent log file if it is needed. File is reopened in new timestamp dir,
+ *        if LIFETIME expired
+ *
+ * @param log_file
+ * @return true success
+ * @return false failure
+ */
+static bool list_log_prepare_persistent_(ListLogFileData* log_file) {
+    assert(log_file);
+
+    const time_t ltime = time(NULL);
+
+    if (log_file->file != nullptr && ltime - log_file->last_write > log_file->LIFETIME)
+        if (!list_log_close_file(log_file))
+            return false;
+
+    if (log_file->file == nullptr) {
+        if (!list_log_register_persistent_(log_file))
+            return false;
+
+        if (log_file->buffer == nullptr) {
+            log_file->buffer = (char*)calloc(log_file->BUFFER_SIZE, sizeof(char));
+
+            if (log_file->buffer == nullptr)
+                return false;
+        }
+
+        if (!list_log_open_file(log_file))
+            return false;
+
+        if (setvbuf(log_file->file, log_file->buffer, _IOFBF, log_file->BUFFER_SIZE) != 0)
+            return false;
+
+        log_file->last_flush = ltime;
+    }
+
+    log_file->last_write = ltime;
+
+    return true;
+}
+
 int list_log_printf(ListLogFileData* log_file, const char* format, ...) {
     assert(log_file);
     assert(format);
 
     bool file_is_opened_here = false;
-    if (log_file->file == nullptr) {
+    if (log_file->is_persistent) {
+        if (!list_log_prepare_persistent_(log_file))
+            return -1;
+    } else if (log_file->file == nullptr) {
         if (!list_log_open_file(log_file))
             return -1;
         file_is_opened_here = true;
@@ -25,9 +117,29 @@ int list_log_printf(ListLogFileData* log_file, const char* format, ...) {
         if (!list_log_close_file(log_file))
             return -1;
 
+    if (log_file->is_persistent && log_file->last_write - log_file->last_flush >= log_file->FLUSH_INTERVAL)
+        if (!list_log_flush(log_file))
+            return -1;
+
     return ret;
 }
 
+bool list_log_flush(ListLogFileData* log_file) {
+    assert(log_file);
+
+    if (log_file->file == nullptr)
+        return true;
+
+    if (fflush(log_file->file) != 0) {
+        perror("Error flushing log_file file");
+        return false;
+    }
+
+    log_file->last_flush = log_file->last_write;
+
+    return true;
+}
+
 bool list_log_open_file(ListLogFileData* log_file, const char* mode) {
     assert(log_file);
 
@@ -30,7 +30,7 @@
 /**
  * @brief Log file data struct
  *
- * @attention You may use LogFileData as global var
+ * @attention You may use LogFileData as global var. Persistent log must live until exit
  */
 struct ListLogFileData {
     // if more than LIFETIME seconds have passed since the last write, a new file will be created
@@ -43,6 +43,14 @@ struct ListLogFileData {
 
     char timestamp_dir[MAX_FILENAME_LEN] = {};
     time_t last_write = 0;
+
+    // persistent mode: file is kept opened between writes, output is buffered
+    static const size_t BUFFER_SIZE    = 1 << 20;   //< buffer is flushed, when it is full
+    static const long   FLUSH_INTERVAL = 1;         //< buffer is flushed, if FLUSH_INTERVAL seconds passed
+
+    bool is_persistent = false;     //< enables persistent mode. It is flushed at exit
+    char* buffer = nullptr;         //< file buffer of persistent mode
+    time_t last_flush = 0;
 };
 
 /**
@@ -65,6 +73,15 @@ int list_log_printf(ListLogFileData* log, const char* format, ...);
  */
 bool list_log_open_file(ListLogFileData* log, const char* mode = "ab");
 
+/**
+ * @brief Writes buffered data of persistent log to file
+ *
+ * @param log
+ * @return true success
+ * @return false failure
+ */
+bool list_log_flush(ListLogFileData* log);
+
 /**
  * @brief Closes log fle
  *
@@ -0,0 +1,384 @@
+#include "list_order_index.h"
+
+#include <math.h>
+
+/**
+ * @brief Returns new block handle or -1 if there are no free handles
+ *
+ * @param index
+ * @return list_idx_t
+ */
+static list_idx_t list_order_index_new_block_(ListOrderIndex* index) {
+    assert(index);
+
+    if (index->handles_num >= index->handles_cap)
+        return -1;
+
+    return index->handles_num++;
+}
+
+/**
+ * @brief Inserts block to order at position at
+ *
+ * @param index
+ * @param at
+ * @param block
+ */
+static void list_order_index_order_insert_(ListOrderIndex* index, const list_idx_t at,
+                                           const list_idx_t block) {
+    assert(index);
+    assert(0 <= at && at <= index->blocks_num);
+
+    memmove(index->order + at + 1, index->order + at,
+            (size_t)(index->blocks_num - at) * sizeof(list_idx_t));
+
+    index->order[at] = block;
+    index->blocks_num++;
+
+    for (list_idx_t i = at; i < index->blocks_num; i++)
+        index->pos[index->order[i]] = i;
+}
+
+/**
+ * @brief Removes block from order
+ *
+ * @param index
+ * @param block
+ */
+static void list_order_index_order_remove_(ListOrderIndex* index, const list_idx_t block) {
+    assert(index);
+
+    const list_idx_t at = index->pos[block];
+
+    memmove(index->order + at, index->order + at + 1,
+            (size_t)(index->blocks_num - at - 1) * sizeof(list_idx_t));
+
+    index->blocks_num--;
+
+    for (list_idx_t i = at; i < index->blocks_num; i++)
+        index->pos[index->order[i]] = i;
+}
+
+/**
+ * @brief Builds index from scratch in O(capacity)
+ *
+ * @param list
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_order_index_rebuild_(const List<T>* list) {
+    assert(list);
+
+    ListOrderIndex* index = list->order_index;
+    assert(index);
+
+    if (index->slots_num != list->capacity) {
+        list_idx_t* block_of = (list_idx_t*)realloc(index->block_of,
+                                                    (size_t)list->capacity * sizeof(list_idx_t));
+        if (block_of == nullptr)
+            return false;
+
+        index->block_of  = block_of;
+        index->slots_num = list->capacity;
+    }
+
+    for (list_idx_t i = 0; i < index->slots_num; i++)
+        index->block_of[i] = -1;
+
+    index->block_size = MAX((list_idx_t)sqrt((double)list->size), 1);
+
+    const list_idx_t handles_cap = (list->size / index->block_size + 1) * 2 + 4;
+
+    if (handles_cap > index->handles_cap) {
+        // first, count, pos and order are parts of one block
+        list_idx_t* arrays = (list_idx_t*)realloc(index->first,
+                                                  4 * (size_t)handles_cap * sizeof(list_idx_t));
+        if (arrays == nullptr)
+            return false;
+
+        index->handles_cap = handles_cap;
+
+        index->first = arrays;
+        index->count = arrays + handles_cap;
+        index->pos   = arrays + handles_cap * 2;
+        index->order = arrays + handles_cap * 3;
+    }
+
+    index->blocks_num  = 0;
+    index->handles_num = 0;
+
+    list_idx_t block = -1;
+    list_idx_t phys_i = list_head(list);
+
+    for (list_idx_t log_i = 0; phys_i > 0 && log_i < list->size; log_i++) {
+        if (log_i % index->block_size == 0) {
+            block = list_order_index_new_block_(index);
+
+            index->first[block] = phys_i;
+            index->count[block] = 0;
+            index->pos[block]   = index->blocks_num;
+            index->order[index->blocks_num++] = block;
+        }
+
+        index->block_of[phys_i] = block;
+        index->count[block]++;
+
+        phys_i = list_next(list, phys_i);
+    }
+
+    index->is_valid = true;
+    return true;
+}
+
+/**
+ * @brief Splits block in two halves
+ *
+ * @param list
+ * @param block
+ */
+template <typename T>
+static void list_order_index_split_(List<T>* list, const list_idx_t block) {
+    assert(list);
+
+    ListOrderIndex* index = list->order_index;
+
+    const list_idx_t new_block = list_order_index_new_block_(index);
+
+    if (new_block == -1) {
+        index->is_valid = false;
+        return;
+    }
+
+    const list_idx_t half = index->count[block] / 2;
+
+    list_idx_t phys_i = index->first[block];
+    for (list_idx_t i = 0; i < half; i++)
+        phys_i = list_next(list, phys_i);
+
+    index->first[new_block] = phys_i;
+    index->count[new_block] = index->count[block] - half;
+    index->count[block]     = half;
+
+    for (list_idx_t i = 0; i < index->count[new_block]; i++) {
+        index->block_of[phys_i] = new_block;
+        phys_i = list_next(list, phys_i);
+    }
+
+    list_order_index_order_insert_(index, index->pos[block] + 1, new_block);
+}
+
+/**
+ * @brief Invalidates index if block size doesn't match list size anymore
+ *
+ * @param list
+ */
+template <typename T>
+static void list_order_index_check_balance_(List<T>* list) {
+    assert(list);
+
+    ListOrderIndex* index = list->order_index;
+    const list_idx_t block_size = index->block_size;
+
+    if (list->size > 4 * block_size * block_size + 4 ||
+        list->size < block_size * block_size / 4 ||
+        index->blocks_num > 2 * (list->size / block_size) + 4)
+        index->is_valid = false;
+}
+
+template <typename T>
+int list_order_index_enable(List<T>* list) {
+    assert(list);
+
+    if (list->order_index != nullptr)
+        return list->OK;
+
+    list->order_index = (ListOrderIndex*)calloc(1, sizeof(ListOrderIndex));
+
+    if (list->order_index == nullptr)
+        return list->ALLOC_ERR;
+
+    return list->OK;
+}
+
+template <typename T>
+void list_order_index_disable(List<T>* list) {
+    assert(list);
+
+    if (list->order_index == nullptr)
+        return;
+
+    free(list->order_index->block_of);
+    free(list->order_index->first);
+
+    FREE(list->order_index);
+}
+
+template <typename T>
+bool list_order_index_find(const List<T>* list, const list_idx_t logical_i, list_idx_t* physical_i) {
+    assert(list);
+    assert(list->order_index);
+    assert(physical_i);
+    assert(0 <= logical_i && logical_i < list->size);
+
+    ListOrderIndex* index = list->order_index;
+
+    if (!index->is_valid && !list_order_index_rebuild_(list))
+        return false;
+
+    list_idx_t rest = logical_i;
+    list_idx_t block = -1;
+
+    for (list_idx_t i = 0; i < index->blocks_num; i++) {
+        block = index->order[i];
+
+        if (rest < index->count[block])
+            break;
+
+        rest -= index->count[block];
+    }
+
+    list_idx_t phys_i = index->first[block];
+    while (rest-- > 0)
+        phys_i = list_next(list, phys_i);
+
+    *physical_i = phys_i;
+    return true;
+}
+
+template <typename T>
+bool list_order_index_logical(const List<T>* list, const list_idx_t physical_i, list_idx_t* logical_i) {
+    assert(list);
+    assert(list->order_index);
+    assert(logical_i);
+    assert(0 < physical_i && physical_i < list->capacity);
+
+    ListOrderIndex* index = list->order_index;
+
+    if (!index->is_valid && !list_order_index_rebuild_(list))
+        return false;
+
+    const list_idx_t block = index->block_of[physical_i];
+
+    if (block == -1) {
+        *logical_i = -1;
+        return true;
+    }
+
+    *logical_i = 0;
+
+    for (list_idx_t i = 0; i < index->pos[block]; i++)
+        *logical_i += index->count[index->order[i]];
+
+    for (list_idx_t phys_i = index->first[block]; phys_i != physical_i; phys_i = list_next(list, phys_i))
+        (*logical_i)++;
+
+    return true;
+}
+
+template <typename T>
+void list_order_index_insert(List<T>* list, const list_idx_t position, const list_idx_t inserted_i) {
+    assert(list);
+
+    ListOrderIndex* index = list->order_index;
+
+    if (index == nullptr || !index->is_valid)
+        return;
+
+    list_idx_t block = -1;
+
+    if (position != 0) {
+        block = index->block_of[position];
+    } else if (index->blocks_num > 0) {
+        // new head
+        block = index->order[0];
+        index->first[block] = inserted_i;
+    } else {
+        block = list_order_index_new_block_(index);
+
+        if (block == -1) {
+            index->is_valid = false;
+            return;
+        }
+
+        index->first[block] = inserted_i;
+        index->count[block] = 0;
+        list_order_index_order_insert_(index, 0, block);
+    }
+
+    index->block_of[inserted_i] = block;
+    index->count[block]++;
+
+    if (index->count[block] > 2 * index->block_size)
+        list_order_index_split_(list, block);
+
+    list_order_index_check_balance_(list);
+}
+
+template <typename T>
+void list_order_index_delete(List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+
+    ListOrderIndex* index = list->order_index;
+
+    if (index == nullptr || !index->is_valid)
+        return;
+
+    const list_idx_t block = index->block_of[phys_i];
+
+    index->block_of[phys_i] = -1;
+    index->count[block]--;
+
+    if (index->count[block] == 0)
+        list_order_index_order_remove_(index, block);
+    else if (index->first[block] == phys_i)
+        index->first[block] = list_next(list, phys_i);
+
+    list_order_index_check_balance_(list);
+}
+
+template <typename T>
+void list_order_index_swap(List<T>* list, const list_idx_t a, const list_idx_t b) {
+    assert(list);
+
+    ListOrderIndex* index = list->order_index;
+
+    if (index == nullptr || !index->is_valid)
+        return;
+
+    const list_idx_t block_a = index->block_of[b];
+    const list_idx_t block_b = index->block_of[a];
+
+    index->block_of[a] = block_a;
+    index->block_of[b] = block_b;
+
+    #define REMAP_(block_)  if (block_ != -1) {                                 \
+                                if (index->first[block_] == a)                  \
+                                    index->first[block_] = b;                   \
+                                else if (index->first[block_] == b)             \
+                                    index->first[block_] = a;                   \
+                            }
+
+    REMAP_(block_a);
+
+    if (block_b != block_a)
+        REMAP_(block_b);
+
+    #undef REMAP_
+}
+
+#define LIST_ORDER_INDEX_INSTANTIATE_(T)                                                            \
+    template int  list_order_index_enable(List<T>* list);                                           \
+    template void list_order_index_disable(List<T>* list);                                          \
+    template bool list_order_index_find(const List<T>* list, const list_idx_t logical_i,            \
+                                        list_idx_t* physical_i);                                    \
+    template bool list_order_index_logical(const List<T>* list, const list_idx_t physical_i,        \
+                                           list_idx_t* logical_i);                                  \
+    template void list_order_index_insert(List<T>* list, const list_idx_t position,                 \
+                                          const list_idx_t inserted_i);                             \
+    template void list_order_index_delete(List<T>* list, const list_idx_t phys_i);                  \
+    template void list_order_index_swap(List<T>* list, const list_idx_t a, const list_idx_t b);
+
+LIST_ELEM_TYPES(LIST_ORDER_INDEX_INSTANTIATE_)
+
+#undef LIST_ORDER_INDEX_INSTANTIATE_
@@ -0,0 +1,111 @@
+#ifndef LIST_ORDER_INDEX_H_
+#define LIST_ORDER_INDEX_H_
+
+#include "list.h"
+
+/**
+ * @brief Order statistic index (sqrt decomposition). List is cut into blocks of about
+ *        block_size sequential elements, so logical <-> physical lookups take O(sqrt(n))
+ *
+ * @attention It is rebuilt lazily (O(n)) on the first lookup after resize or linearisation
+ */
+struct ListOrderIndex {
+    list_idx_t* block_of = nullptr;     //< block handle of every slot (-1 for free slots)
+    list_idx_t  slots_num = 0;          //< block_of array length
+
+    list_idx_t* first = nullptr;        //< physical index of the first element of every block
+    list_idx_t* count = nullptr;        //< number of elements in every block
+    list_idx_t* pos   = nullptr;        //< position of every block in order
+    list_idx_t* order = nullptr;        //< block handles in logical order
+
+    list_idx_t blocks_num  = 0;         //< number of blocks in order
+    list_idx_t handles_num = 0;         //< number of used block handles
+    list_idx_t handles_cap = 0;         //< block arrays length
+
+    list_idx_t block_size = 0;          //< block is split, when it becomes 2 times bigger
+
+    bool is_valid = false;              //< false if index has to be rebuilt
+};
+
+/**
+ * @brief Creates order index for list. Insert and delete update it incrementally
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_order_index_enable(List<T>* list);
+
+/**
+ * @brief Destroys list order index
+ *
+ * @param list
+ */
+template <typename T>
+void list_order_index_disable(List<T>* list);
+
+/**
+ * @brief Marks index to be rebuilt on next lookup
+ *
+ * @param list
+ */
+template <typename T>
+inline void list_order_index_invalidate(const List<T>* list) {
+    if (list->order_index != nullptr)
+        list->order_index->is_valid = false;
+}
+
+/**
+ * @brief Finds physical index of element with given logical index in O(sqrt(n))
+ *
+ * @param list
+ * @param logical_i
+ * @param physical_i returnable value
+ * @return true success
+ * @return false index can't be built
+ */
+template <typename T>
+bool list_order_index_find(const List<T>* list, const list_idx_t logical_i, list_idx_t* physical_i);
+
+/**
+ * @brief Finds logical index of element with given physical index in O(sqrt(n))
+ *
+ * @param list
+ * @param physical_i
+ * @param logical_i returnable value. -1 if slot is free
+ * @return true success
+ * @return false index can't be built
+ */
+template <typename T>
+bool list_order_index_logical(const List<T>* list, const list_idx_t physical_i, list_idx_t* logical_i);
+
+/**
+ * @brief Updates index after element inserted_i was linked after position
+ *
+ * @param list
+ * @param position
+ * @param inserted_i
+ */
+template <typename T>
+void list_order_index_insert(List<T>* list, const list_idx_t position, const list_idx_t inserted_i);
+
+/**
+ * @brief Updates index before element phys_i is unlinked
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+void list_order_index_delete(List<T>* list, const list_idx_t phys_i);
+
+/**
+ * @brief Updates index after contents of slots a and b were swapped
+ *
+ * @param list
+ * @param a
+ * @param b
+ */
+template <typename T>
+void list_order_index_swap(List<T>* list, const list_idx_t a, const list_idx_t b);
+
+#endif //< #ifndef LIST_ORDER_INDEX_H_
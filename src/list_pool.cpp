@@ -0,0 +1,483 @@
+#include "list_pool.h"
+#include "list_alloc.h"
+
+#ifndef NDEBUG
+
+    // pool has no dump, so only error is printed
+    #define LIST_POOL_OK_(res)  do {                                    \
+                                    if (res != ListBase::OK)            \
+                                        list_print_error(res);          \
+                                } while (0)
+
+    #define LIST_POOL_ASSERT_(pool, list)                   \
+                list_pool_list_verify(pool, list);          \
+                LIST_POOL_OK_(res);                         \
+                                                            \
+                if (res != ListBase::OK)                    \
+                    return res
+
+#else //< #ifdef NDEBUG
+
+    #define LIST_POOL_OK_(res) (void) 0
+
+    #define LIST_POOL_ASSERT_(pool, list) ListBase::OK
+
+#endif //< #ifndef NDEBUG
+
+#define CHECK_AND_RETURN(clause_, error_, ...)  if (clause_) {          \
+                                                    res |= error_;      \
+                                                    LIST_POOL_OK_(res); \
+                                                    __VA_ARGS__;        \
+                                                    return res;         \
+                                                }
+
+/**
+ * @brief Sets all node fields
+ *
+ * @param pool
+ * @param i physical index
+ * @param prev
+ * @param elem
+ * @param next
+ */
+template <typename T>
+static void list_pool_node_set_(ListPool<T>* pool, const list_idx_t i, const list_idx_t prev, const T elem,
+                                const list_idx_t next) {
+    list_pool_prev(pool, i) = prev;
+    list_pool_elem(pool, i) = elem;
+    list_pool_next(pool, i) = next;
+}
+
+/**
+ * @brief Doubles pool capacity. Physical indexes are kept
+ *
+ * @param pool
+ * @return true success
+ * @return false allocation error or capacity overflow
+ */
+template <typename T>
+static bool list_pool_grow_(ListPool<T>* pool) {
+    assert(pool);
+
+    if (pool->capacity > LIST_IDX_MAX / 2)
+        return false;
+
+    const list_idx_t new_capacity = pool->capacity * 2;
+
+    // new nodes are over free_watermark, so they aren't initialised
+    void* arr = list_allocator_realloc(&pool->allocator, pool->arr,
+                                       (size_t)pool->capacity * sizeof(ListNode<T>),
+                                       (size_t)new_capacity   * sizeof(ListNode<T>));
+    if (arr == nullptr)
+        return false;
+
+    pool->arr = (ListNode<T>*)arr;
+    pool->capacity = new_capacity;
+
+    return true;
+}
+
+/**
+ * @brief Takes free node: free list head or the first node over free_watermark. Pool grows if it is full
+ *
+ * @param pool
+ * @return list_idx_t 0 on allocation error
+ */
+template <typename T>
+static list_idx_t list_pool_take_(ListPool<T>* pool) {
+    assert(pool);
+
+    if (pool->free_head != 0) {
+        const list_idx_t phys_i = pool->free_head;
+
+        pool->free_head = list_pool_next(pool, phys_i);
+        pool->used++;
+
+        return phys_i;
+    }
+
+    if (pool->free_watermark == pool->capacity && !list_pool_grow_(pool))
+        return 0;
+
+    pool->used++;
+
+    return pool->free_watermark++;
+}
+
+/**
+ * @brief Returns node to free list and poisons it
+ *
+ * @param pool
+ * @param phys_i
+ */
+template <typename T>
+static void list_pool_release_(ListPool<T>* pool, const list_idx_t phys_i) {
+    assert(pool);
+    assert(0 < phys_i && phys_i < pool->free_watermark);
+
+    list_pool_node_set_(pool, phys_i, ListNode<T>::EMPTY_INDEX, ListNode<T>::POISON, pool->free_head);
+
+    pool->free_head = phys_i;
+    pool->used--;
+}
+
+template <typename T>
+int list_pool_ctor(ListPool<T>* pool, size_t init_capacity) {
+    assert(pool);
+
+    int res = pool->OK;
+
+    CHECK_AND_RETURN(pool->arr != nullptr || pool->capacity != pool->UNITIALISED_VAL, pool->ALREADY_INITIALISED);
+
+    CHECK_AND_RETURN(init_capacity >= (size_t)LIST_IDX_MAX / 2, pool->INVALID_CAPACITY);
+
+    init_capacity++; //< node 0 isn't used, so 0 ends free list
+
+    pool->arr = (ListNode<T>*)list_allocator_alloc(&pool->allocator, init_capacity * sizeof(ListNode<T>));
+
+    CHECK_AND_RETURN(pool->arr == nullptr, pool->ALLOC_ERR);
+
+    list_pool_node_set_(pool, 0, ListNode<T>::EMPTY_INDEX, ListNode<T>::POISON, ListNode<T>::EMPTY_INDEX);
+
+    pool->capacity       = (list_idx_t)init_capacity;
+    pool->used           = 0;
+    pool->free_head      = 0;
+    pool->free_watermark = 1;
+
+    return res;
+}
+
+template <typename T>
+int list_pool_dtor(ListPool<T>* pool) {
+    assert(pool);
+
+    int res = list_pool_verify(pool);
+    LIST_POOL_OK_(res);
+
+    if (pool->arr == nullptr)
+        return res;
+
+#ifndef NDEBUG
+    // freed nodes are poisoned to catch use after destruction. Nodes over free_watermark were never touched
+    const list_idx_t used_end = MIN(MAX(pool->free_watermark, 0), pool->capacity);
+
+    for (list_idx_t i = 0; i < used_end; i++)
+        list_pool_node_set_(pool, i, ListNode<T>::EMPTY_INDEX, ListNode<T>::POISON, ListNode<T>::EMPTY_INDEX);
+#endif //< #ifndef NDEBUG
+
+    list_allocator_free(&pool->allocator, pool->arr, (size_t)pool->capacity * sizeof(ListNode<T>));
+
+    pool->arr            = nullptr;
+    pool->capacity       = pool->UNITIALISED_VAL;
+    pool->used           = pool->UNITIALISED_VAL;
+    pool->free_head      = pool->UNITIALISED_VAL;
+    pool->free_watermark = pool->UNITIALISED_VAL;
+
+    return res;
+}
+
+template <typename T>
+int list_pool_list_ctor(ListPool<T>* pool, ListPoolList* list) {
+    assert(pool);
+    assert(list);
+
+    int res = pool->OK;
+
+    CHECK_AND_RETURN(pool->arr == nullptr, pool->UNITIALISED);
+    CHECK_AND_RETURN(list->sentinel != ListBase::UNITIALISED_VAL, pool->ALREADY_INITIALISED);
+
+    const list_idx_t sentinel = list_pool_take_(pool);
+
+    CHECK_AND_RETURN(sentinel == 0, pool->ALLOC_ERR);
+
+    list_pool_node_set_(pool, sentinel, sentinel, ListNode<T>::POISON, sentinel);
+
+    list->sentinel  = sentinel;
+    list->size      = 0;
+    list->is_linear = true;
+
+    return res;
+}
+
+template <typename T>
+int list_pool_list_dtor(ListPool<T>* pool, ListPoolList* list) {
+    assert(pool);
+    assert(list);
+
+    int res = LIST_POOL_ASSERT_(pool, list);
+
+    list_idx_t phys_i = list_pool_head(pool, list);
+
+    while (phys_i != list->sentinel) {
+        const list_idx_t next = list_pool_next(pool, phys_i);
+
+        list_pool_release_(pool, phys_i);
+        phys_i = next;
+    }
+
+    list_pool_release_(pool, list->sentinel);
+
+    list->sentinel  = ListBase::UNITIALISED_VAL;
+    list->size      = ListBase::UNITIALISED_VAL;
+    list->is_linear = false;
+
+    return res;
+}
+
+template <typename T>
+int list_pool_insert_after(ListPool<T>* pool, ListPoolList* list, const list_idx_t position, const T elem,
+                           list_idx_t* inserted_index) {
+    assert(inserted_index);
+
+    int res = LIST_POOL_ASSERT_(pool, list);
+
+    CHECK_AND_RETURN(position <= 0 || list_pool_is_free(pool, position), pool->INVALID_POSITION);
+    CHECK_AND_RETURN(list_is_poison(elem), pool->POISON_VAL_FOUND);
+
+    const list_idx_t inserted = list_pool_take_(pool);
+
+    CHECK_AND_RETURN(inserted == 0, pool->ALLOC_ERR);
+
+    const list_idx_t next = list_pool_next(pool, position);
+
+    list_pool_node_set_(pool, inserted, position, elem, next);
+
+    list_pool_prev(pool, next)     = inserted;
+    list_pool_next(pool, position) = inserted;
+
+    // list stays linear, if element is appended right after its tail slot
+    list->is_linear = list->is_linear && next == list->sentinel && inserted == list->sentinel + list->size + 1;
+    list->size++;
+
+    *inserted_index = inserted;
+
+    return res | LIST_POOL_ASSERT_(pool, list);
+}
+
+template <typename T>
+int list_pool_delete(ListPool<T>* pool, ListPoolList* list, const list_idx_t position) {
+    int res = LIST_POOL_ASSERT_(pool, list);
+
+    CHECK_AND_RETURN(position <= 0 || position == list->sentinel || list_pool_is_free(pool, position),
+                     pool->INVALID_POSITION);
+
+    const list_idx_t prev = list_pool_prev(pool, position);
+    const list_idx_t next = list_pool_next(pool, position);
+
+    list_pool_next(pool, prev) = next;
+    list_pool_prev(pool, next) = prev;
+
+    list_pool_release_(pool, position);
+
+    // tail deletion keeps elements sequential
+    list->is_linear = list->is_linear && next == list->sentinel;
+    list->size--;
+
+    return res | LIST_POOL_ASSERT_(pool, list);
+}
+
+template <typename T>
+int list_pool_splice(ListPool<T>* pool, ListPoolList* dst, const list_idx_t dst_pos, ListPoolList* src,
+                     const list_idx_t first, const list_idx_t last, const list_idx_t n) {
+    int res = LIST_POOL_ASSERT_(pool, dst);
+    res |= LIST_POOL_ASSERT_(pool, src);
+
+    CHECK_AND_RETURN(dst_pos <= 0 || list_pool_is_free(pool, dst_pos), pool->INVALID_POSITION);
+    CHECK_AND_RETURN(first <= 0 || first == src->sentinel || list_pool_is_free(pool, first),
+                     pool->INVALID_POSITION);
+    CHECK_AND_RETURN(last <= 0 || last == src->sentinel || list_pool_is_free(pool, last),
+                     pool->INVALID_POSITION);
+    CHECK_AND_RETURN(n <= 0 || n > src->size, pool->INVALID_POSITION);
+
+#ifndef NDEBUG
+    // range must be n elements of src without dst_pos. It is checked in O(n) only in debug mode
+    list_idx_t range_size = 0;
+
+    for (list_idx_t phys_i = first; ; phys_i = list_pool_next(pool, phys_i)) {
+        CHECK_AND_RETURN(phys_i == src->sentinel || (dst == src && phys_i == dst_pos) || range_size == n,
+                         pool->INVALID_POSITION);
+
+        range_size++;
+
+        if (phys_i == last)
+            break;
+    }
+
+    CHECK_AND_RETURN(range_size != n, pool->INVALID_POSITION);
+#endif //< #ifndef NDEBUG
+
+    const list_idx_t prev = list_pool_prev(pool, first);
+    const list_idx_t next = list_pool_next(pool, last);
+
+    if (dst == src && prev == dst_pos)
+        return res;
+
+    // nodes stay in their slots, only range ends are relinked
+    list_pool_next(pool, prev) = next;
+    list_pool_prev(pool, next) = prev;
+
+    const list_idx_t dst_next = list_pool_next(pool, dst_pos);
+
+    list_pool_prev(pool, first)    = dst_pos;
+    list_pool_next(pool, last)     = dst_next;
+    list_pool_prev(pool, dst_next) = last;
+    list_pool_next(pool, dst_pos)  = first;
+
+    if (dst != src) {
+        // tail deletion keeps elements sequential
+        src->is_linear = src->is_linear && next == src->sentinel;
+        src->size -= n;
+
+        dst->size += n;
+    }
+
+    dst->is_linear = false;
+
+    res |= LIST_POOL_ASSERT_(pool, src);
+
+    return res | LIST_POOL_ASSERT_(pool, dst);
+}
+
+template <typename T>
+int list_pool_find_by_logical(const ListPool<T>* pool, const ListPoolList* list, const list_idx_t logical_i,
+                              list_idx_t* physical_i) {
+    assert(physical_i);
+
+    int res = LIST_POOL_ASSERT_(pool, list);
+
+    CHECK_AND_RETURN(logical_i < 0 || logical_i >= list->size, pool->INVALID_POSITION, {
+                                                                   *physical_i = -1;});
+
+    if (list->is_linear) {
+        *physical_i = list->sentinel + 1 + logical_i;
+        return res;
+    }
+
+    list_idx_t phys_i = list_pool_head(pool, list);
+
+    for (list_idx_t log_i = 0; log_i < logical_i; log_i++)
+        phys_i = list_pool_next(pool, phys_i);
+
+    *physical_i = phys_i;
+
+    return res;
+}
+
+#define CHECK_ERR_(clause, err) if (clause) res |= err
+
+/**
+ * @brief Verifies pool fields in O(1)
+ *
+ * @param pool
+ * @return int
+ */
+template <typename T>
+static int list_pool_verify_fields_(const ListPool<T>* pool) {
+    assert(pool);
+
+    int res = pool->OK;
+
+    if (pool->arr == nullptr)
+        return pool->UNITIALISED;
+
+    CHECK_ERR_(pool->capacity <= 0, pool->NEGATIVE_CAPACITY);
+    CHECK_ERR_(pool->used < 0, pool->NEGATIVE_SIZE);
+    CHECK_ERR_(pool->free_watermark <= 0 || pool->free_watermark > pool->capacity, pool->INVALID_FREE_HEAD);
+    CHECK_ERR_(pool->free_head < 0 || pool->free_head >= MAX(pool->free_watermark, 1), pool->INVALID_FREE_HEAD);
+    CHECK_ERR_(pool->used > pool->free_watermark - 1, pool->LOW_CAPACITY);
+
+    return res;
+}
+
+template <typename T>
+int list_pool_verify(const ListPool<T>* pool) {
+    assert(pool);
+
+    int res = list_pool_verify_fields_(pool);
+
+    if (res != pool->OK)
+        return res;
+
+    // free list is walked at most (free_watermark - 1 - used) steps, so a cycle doesn't hang it
+    const list_idx_t free_num = pool->free_watermark - 1 - pool->used;
+
+    list_idx_t phys_i = pool->free_head;
+    list_idx_t free_i = 0;
+
+    for (; phys_i != 0 && free_i < free_num; free_i++) {
+        if (phys_i <= 0 || phys_i >= pool->free_watermark || list_pool_prev(pool, phys_i) >= 0)
+            return res | pool->DAMAGED_FREE_LIST;
+
+        CHECK_ERR_(!list_is_poison(list_pool_elem(pool, phys_i)), pool->NON_POISON_EMPTY);
+
+        phys_i = list_pool_next(pool, phys_i);
+    }
+
+    CHECK_ERR_(phys_i != 0 || free_i != free_num, pool->DAMAGED_FREE_LIST);
+
+    return res;
+}
+
+template <typename T>
+int list_pool_list_verify(const ListPool<T>* pool, const ListPoolList* list) {
+    assert(pool);
+    assert(list);
+
+    int res = list_pool_verify_fields_(pool);
+
+    if (res != pool->OK)
+        return res;
+
+    if (list->sentinel == ListBase::UNITIALISED_VAL)
+        return pool->UNITIALISED;
+
+    if (list->sentinel <= 0 || list_pool_is_free(pool, list->sentinel))
+        return pool->INVALID_HEAD;
+
+    CHECK_ERR_(list->size < 0, pool->NEGATIVE_SIZE);
+
+    list_idx_t prev_phys_i = list->sentinel;
+
+    list_idx_t phys_i = list_pool_head(pool, list);
+    list_idx_t log_i = 0;
+
+    for (; phys_i != list->sentinel && log_i < list->size; log_i++) {
+        if (phys_i <= 0 || list_pool_is_free(pool, phys_i))
+            return res | pool->DAMAGED_PATH;
+
+        CHECK_ERR_(list_is_poison(list_pool_elem(pool, phys_i)), pool->POISON_VAL_FOUND);
+        CHECK_ERR_(list_pool_prev(pool, phys_i) != prev_phys_i, pool->DAMAGED_PATH);
+
+        CHECK_ERR_(list->is_linear && phys_i != list->sentinel + 1 + log_i, pool->INVALID_IS_LINEAR);
+
+        prev_phys_i = phys_i;
+        phys_i = list_pool_next(pool, phys_i);
+    }
+
+    CHECK_ERR_(phys_i != list->sentinel || log_i != list->size, pool->DAMAGED_PATH);
+    CHECK_ERR_(list_pool_tail(pool, list) != prev_phys_i, pool->INVALID_TAIL);
+
+    return res;
+}
+
+#undef CHECK_ERR_
+
+#define LIST_POOL_INSTANTIATE_(T)                                                                       \
+    template int list_pool_ctor(ListPool<T>* pool, size_t init_capacity);                               \
+    template int list_pool_dtor(ListPool<T>* pool);                                                     \
+    template int list_pool_list_ctor(ListPool<T>* pool, ListPoolList* list);                            \
+    template int list_pool_list_dtor(ListPool<T>* pool, ListPoolList* list);                            \
+    template int list_pool_insert_after(ListPool<T>* pool, ListPoolList* list, const list_idx_t position,\
+                                        const T elem, list_idx_t* inserted_index);                      \
+    template int list_pool_delete(ListPool<T>* pool, ListPoolList* list, const list_idx_t position);    \
+    template int list_pool_splice(ListPool<T>* pool, ListPoolList* dst, const list_idx_t dst_pos,       \
+                                  ListPoolList* src, const list_idx_t first, const list_idx_t last,     \
+                                  const list_idx_t n);                                                  \
+    template int list_pool_find_by_logical(const ListPool<T>* pool, const ListPoolList* list,           \
+                                           const list_idx_t logical_i, list_idx_t* physical_i);         \
+    template int list_pool_verify(const ListPool<T>* pool);                                             \
+    template int list_pool_list_verify(const ListPool<T>* pool, const ListPoolList* list);
+
+LIST_ELEM_TYPES(LIST_POOL_INSTANTIATE_)
+
+#undef LIST_POOL_INSTANTIATE_
@@ -0,0 +1,246 @@
+#ifndef LIST_POOL_H_
+#define LIST_POOL_H_
+
+#include "list.h"
+
+/**
+ * @brief Node array and free list shared by many small lists. Lists don't have their own arrays and
+ *        headroom, and lists built one after another are stored next to each other
+ *
+ * @attention Nodes of one list are used together, so pool is always array of structures
+ *
+ * @tparam T element type
+ */
+template <typename T>
+struct ListPool : ListBase {
+    ListNode<T>* arr = nullptr;     //< nodes of all lists. Node 0 isn't used
+
+    list_idx_t capacity  = UNITIALISED_VAL;     //< array capacity
+    list_idx_t used      = UNITIALISED_VAL;     //< number of used nodes (elements and sentinels)
+    list_idx_t free_head = UNITIALISED_VAL;     //< first free node (0 if free list is empty)
+
+    // nodes [free_watermark, capacity) are free, but they aren't in free list and aren't initialised
+    list_idx_t free_watermark = UNITIALISED_VAL;
+
+    ListAllocator allocator = {};   //< array allocator. It is set before list_pool_ctor
+};
+
+/**
+ * @brief List stored in ListPool. Its own sentinel node plays role of List node 0
+ */
+struct ListPoolList {
+    list_idx_t sentinel = ListBase::UNITIALISED_VAL;    //< physical index of sentinel node
+    list_idx_t size     = ListBase::UNITIALISED_VAL;    //< number of elements in list
+
+    bool is_linear = false;     //< elements are stored sequentially right after sentinel
+};
+
+template <typename T>
+inline list_idx_t& list_pool_next(ListPool<T>* pool, const list_idx_t i) { return pool->arr[i].next; }
+template <typename T>
+inline list_idx_t& list_pool_prev(ListPool<T>* pool, const list_idx_t i) { return pool->arr[i].prev; }
+template <typename T>
+inline T&          list_pool_elem(ListPool<T>* pool, const list_idx_t i) { return pool->arr[i].elem; }
+
+template <typename T>
+inline list_idx_t list_pool_next(const ListPool<T>* pool, const list_idx_t i) { return pool->arr[i].next; }
+template <typename T>
+inline list_idx_t list_pool_prev(const ListPool<T>* pool, const list_idx_t i) { return pool->arr[i].prev; }
+template <typename T>
+inline const T&   list_pool_elem(const ListPool<T>* pool, const list_idx_t i) { return pool->arr[i].elem; }
+
+/**
+ * @brief Returns true if pool node is free
+ *
+ * @param pool
+ * @param i physical index
+ * @return true
+ * @return false
+ */
+template <typename T>
+inline bool list_pool_is_free(const ListPool<T>* pool, const list_idx_t i) {
+    return i >= pool->free_watermark || list_pool_prev(pool, i) < 0;
+}
+
+/**
+ * @brief Returns list head index (sentinel if list is empty)
+ *
+ * @param pool
+ * @param list
+ * @return list_idx_t
+ */
+template <typename T>
+inline list_idx_t list_pool_head(const ListPool<T>* pool, const ListPoolList* list) {
+    return list_pool_next(pool, list->sentinel);
+}
+
+/**
+ * @brief Returns list tail index (sentinel if list is empty)
+ *
+ * @param pool
+ * @param list
+ * @return list_idx_t
+ */
+template <typename T>
+inline list_idx_t list_pool_tail(const ListPool<T>* pool, const ListPoolList* list) {
+    return list_pool_prev(pool, list->sentinel);
+}
+
+/**
+ * @brief Pool constructor
+ *
+ * @param pool
+ * @param init_capacity number of nodes
+ * @return int
+ */
+template <typename T>
+int list_pool_ctor(ListPool<T>* pool, size_t init_capacity = ListBase::DEFAULT_CAPACITY);
+
+/**
+ * @brief Pool destructor. Lists stored in pool become invalid
+ *
+ * @param pool
+ * @return int
+ */
+template <typename T>
+int list_pool_dtor(ListPool<T>* pool);
+
+/**
+ * @brief Creates empty list in pool (takes sentinel node)
+ *
+ * @param pool
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_pool_list_ctor(ListPool<T>* pool, ListPoolList* list);
+
+/**
+ * @brief Returns all list nodes to pool in O(size)
+ *
+ * @param pool
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_pool_list_dtor(ListPool<T>* pool, ListPoolList* list);
+
+/**
+ * @brief Inserts element after physical index
+ *
+ * @param pool
+ * @param list
+ * @param position physical index of list element or list sentinel
+ * @param elem
+ * @param inserted_index returns physical index of inserted element
+ * @return int
+ */
+template <typename T>
+int list_pool_insert_after(ListPool<T>* pool, ListPoolList* list, const list_idx_t position, const T elem,
+                           list_idx_t* inserted_index);
+
+/**
+ * @brief Inserts element before physical index
+ *
+ * @param pool
+ * @param list
+ * @param position physical index of list element or list sentinel
+ * @param elem
+ * @param inserted_index returns physical index of inserted element
+ * @return int
+ */
+template <typename T>
+inline int list_pool_insert_before(ListPool<T>* pool, ListPoolList* list, const list_idx_t position,
+                                   const T elem, list_idx_t* inserted_index) {
+    return list_pool_insert_after(pool, list, list_pool_prev(pool, position), elem, inserted_index);
+}
+
+/**
+ * @brief Inserts element at the end of the list
+ *
+ * @param pool
+ * @param list
+ * @param elem
+ * @param inserted_index returns physical index of inserted element
+ * @return int
+ */
+template <typename T>
+inline int list_pool_pushback(ListPool<T>* pool, ListPoolList* list, const T elem, list_idx_t* inserted_index) {
+    return list_pool_insert_after(pool, list, list_pool_tail(pool, list), elem, inserted_index);
+}
+
+/**
+ * @brief Inserts element at the beginning of the list
+ *
+ * @param pool
+ * @param list
+ * @param elem
+ * @param inserted_index returns physical index of inserted element
+ * @return int
+ */
+template <typename T>
+inline int list_pool_pushfront(ListPool<T>* pool, ListPoolList* list, const T elem, list_idx_t* inserted_index) {
+    return list_pool_insert_after(pool, list, list->sentinel, elem, inserted_index);
+}
+
+/**
+ * @brief Deletes element
+ *
+ * @param pool
+ * @param list
+ * @param position physical index of list element
+ * @return int
+ */
+template <typename T>
+int list_pool_delete(ListPool<T>* pool, ListPoolList* list, const list_idx_t position);
+
+/**
+ * @brief Moves range of elements of src after physical index of dst in O(1). Nodes stay in their
+ *        slots of pool array, so nothing is copied
+ *
+ * @param pool
+ * @param dst
+ * @param dst_pos physical index of dst element or dst sentinel. It must not be in range, if dst is src
+ * @param src may be dst
+ * @param first physical index of the first element in src
+ * @param last physical index of the last element in src. It must follow first in logical order
+ * @param n number of elements in range. Range is checked to have n elements only in debug mode
+ * @return int
+ */
+template <typename T>
+int list_pool_splice(ListPool<T>* pool, ListPoolList* dst, const list_idx_t dst_pos, ListPoolList* src,
+                     const list_idx_t first, const list_idx_t last, const list_idx_t n);
+
+/**
+ * @brief Finds physical index of element by its logical index. O(1) for linear list
+ *
+ * @param pool
+ * @param list
+ * @param logical_i
+ * @param physical_i returnable value. -1 if logical_i is invalid
+ * @return int
+ */
+template <typename T>
+int list_pool_find_by_logical(const ListPool<T>* pool, const ListPoolList* list, const list_idx_t logical_i,
+                              list_idx_t* physical_i);
+
+/**
+ * @brief Verifies pool fields and free list in O(capacity)
+ *
+ * @param pool
+ * @return int
+ */
+template <typename T>
+int list_pool_verify(const ListPool<T>* pool);
+
+/**
+ * @brief Verifies pool fields and one list in O(list size)
+ *
+ * @param pool
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_pool_list_verify(const ListPool<T>* pool, const ListPoolList* list);
+
+#endif //< #ifndef LIST_POOL_H_
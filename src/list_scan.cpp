@@ -0,0 +1,208 @@
+#include "list_scan.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(LIST_SCAN_NO_SIMD)
+    #define LIST_SCAN_X86_
+    #include <immintrin.h>
+#endif //< #if (defined(__x86_64__) || defined(__i386__)) && !defined(LIST_SCAN_NO_SIMD)
+
+/**
+ * @brief Scalar kernel. Used as fallback and for tails of vector kernels
+ *
+ * @param elems
+ * @param from
+ * @param to
+ * @param key
+ * @return list_idx_t
+ */
+template <typename T>
+static list_idx_t list_scan_scalar_(const T* elems, list_idx_t from, const list_idx_t to, const T key) {
+    for (; from < to; from++)
+        if (ListElemTraits<T>::equal(elems[from], key))
+            return from;
+
+    return -1;
+}
+
+#ifdef LIST_SCAN_X86_
+
+/**
+ * @brief Vector kernels. Every one checks one vector per iteration and finds hit by comparison mask
+ */
+
+// integer kernels are selected by element size (int32 kernels take 4-byte T, int64 ones 8-byte T),
+// because long is 32-bit on LLP64 targets
+
+template <typename T>
+__attribute__((target("avx2")))
+static list_idx_t list_scan_int32_avx2_(const T* elems, list_idx_t from, const list_idx_t to, const T key) {
+    const __m256i keys = _mm256_set1_epi32((int)key);
+
+    for (; from + 8 <= to; from += 8) {
+        const __m256i vals = _mm256_loadu_si256((const __m256i*)(elems + from));
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(vals, keys)));
+
+        if (mask != 0)
+            return from + __builtin_ctz((unsigned)mask);
+    }
+
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+template <typename T>
+static list_idx_t list_scan_int32_sse2_(const T* elems, list_idx_t from, const list_idx_t to, const T key) {
+    const __m128i keys = _mm_set1_epi32((int)key);
+
+    for (; from + 4 <= to; from += 4) {
+        const __m128i vals = _mm_loadu_si128((const __m128i*)(elems + from));
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(vals, keys)));
+
+        if (mask != 0)
+            return from + __builtin_ctz((unsigned)mask);
+    }
+
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+template <typename T>
+__attribute__((target("avx2")))
+static list_idx_t list_scan_int64_avx2_(const T* elems, list_idx_t from, const list_idx_t to, const T key) {
+    const __m256i keys = _mm256_set1_epi64x((long long)key);
+
+    for (; from + 4 <= to; from += 4) {
+        const __m256i vals = _mm256_loadu_si256((const __m256i*)(elems + from));
+        const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(vals, keys)));
+
+        if (mask != 0)
+            return from + __builtin_ctz((unsigned)mask);
+    }
+
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+template <typename T>
+__attribute__((target("sse4.1")))
+static list_idx_t list_scan_int64_sse4_(const T* elems, list_idx_t from, const list_idx_t to, const T key) {
+    const __m128i keys = _mm_set1_epi64x((long long)key);
+
+    for (; from + 2 <= to; from += 2) {
+        const __m128i vals = _mm_loadu_si128((const __m128i*)(elems + from));
+        const int mask = _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(vals, keys)));
+
+        if (mask != 0)
+            return from + __builtin_ctz((unsigned)mask);
+    }
+
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+// ListElemTraits<double>::equal is false for unordered values, so comparisons are EQ_OQ
+
+__attribute__((target("avx")))
+static list_idx_t list_scan_double_avx_(const double* elems, list_idx_t from, const list_idx_t to,
+                                        const double key) {
+    const __m256d keys = _mm256_set1_pd(key);
+
+    for (; from + 4 <= to; from += 4) {
+        const __m256d vals = _mm256_loadu_pd(elems + from);
+        const int mask = _mm256_movemask_pd(_mm256_cmp_pd(vals, keys, _CMP_EQ_OQ));
+
+        if (mask != 0)
+            return from + __builtin_ctz((unsigned)mask);
+    }
+
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+static list_idx_t list_scan_double_sse2_(const double* elems, list_idx_t from, const list_idx_t to,
+                                         const double key) {
+    const __m128d keys = _mm_set1_pd(key);
+
+    for (; from + 2 <= to; from += 2) {
+        const __m128d vals = _mm_loadu_pd(elems + from);
+        const int mask = _mm_movemask_pd(_mm_cmpeq_pd(vals, keys));
+
+        if (mask != 0)
+            return from + __builtin_ctz((unsigned)mask);
+    }
+
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+#endif //< #ifdef LIST_SCAN_X86_
+
+/**
+ * @brief Kernel type for every element type
+ */
+template <typename T>
+using ListScanFunc = list_idx_t (*)(const T* elems, list_idx_t from, const list_idx_t to, const T key);
+
+/**
+ * @brief Selects best kernel CPU supports
+ */
+template <typename T>
+static ListScanFunc<T> list_scan_select_integer_() {
+#ifdef LIST_SCAN_X86_
+    if (sizeof(T) == 4) {
+        if (__builtin_cpu_supports("avx2"))
+            return list_scan_int32_avx2_<T>;
+
+        return list_scan_int32_sse2_<T>;
+    }
+
+    if (sizeof(T) == 8) {
+        if (__builtin_cpu_supports("avx2"))
+            return list_scan_int64_avx2_<T>;
+
+        if (__builtin_cpu_supports("sse4.1"))
+            return list_scan_int64_sse4_<T>;
+    }
+#endif //< #ifdef LIST_SCAN_X86_
+
+    return list_scan_scalar_<T>;
+}
+
+static ListScanFunc<double> list_scan_select_double_() {
+#ifdef LIST_SCAN_X86_
+    if (__builtin_cpu_supports("avx"))
+        return list_scan_double_avx_;
+
+    return list_scan_double_sse2_;
+#else //< #ifndef LIST_SCAN_X86_
+    return list_scan_scalar_<double>;
+#endif //< #ifdef LIST_SCAN_X86_
+}
+
+list_idx_t list_scan_find(const int* elems, list_idx_t from, const list_idx_t to, const int key) {
+    static const ListScanFunc<int> func = list_scan_select_integer_<int>();
+
+    return func(elems, from, to, key);
+}
+
+list_idx_t list_scan_find(const long* elems, list_idx_t from, const list_idx_t to, const long key) {
+    static const ListScanFunc<long> func = list_scan_select_integer_<long>();
+
+    return func(elems, from, to, key);
+}
+
+list_idx_t list_scan_find(const double* elems, list_idx_t from, const list_idx_t to, const double key) {
+    static const ListScanFunc<double> func = list_scan_select_double_();
+
+    return func(elems, from, to, key);
+}
+
+list_idx_t list_scan_find(const long double* elems, list_idx_t from, const list_idx_t to,
+                          const long double key) {
+    // x87 type has no vector instructions
+    return list_scan_scalar_(elems, from, to, key);
+}
+
+const char* list_scan_isa() {
+#ifdef LIST_SCAN_X86_
+    if (__builtin_cpu_supports("avx2"))
+        return "avx2";
+
+    return "sse";
+#else //< #ifndef LIST_SCAN_X86_
+    return "scalar";
+#endif //< #ifdef LIST_SCAN_X86_
+}
@@ -0,0 +1,30 @@
+#ifndef LIST_SCAN_H_
+#define LIST_SCAN_H_
+
+#include "list.h"
+
+/**
+ * @brief Returns first index i from [from, to), such that elems[i] equals key. Uses AVX2/SSE
+ *        if CPU supports it (checked once at runtime) or scalar loop otherwise
+ *
+ * @attention Define LIST_SCAN_NO_SIMD to use only scalar loop
+ *
+ * @param elems contiguous elements array
+ * @param from
+ * @param to
+ * @param key
+ * @return list_idx_t -1 if not found
+ */
+list_idx_t list_scan_find(const int*         elems, list_idx_t from, const list_idx_t to, const int         key);
+list_idx_t list_scan_find(const long*        elems, list_idx_t from, const list_idx_t to, const long        key);
+list_idx_t list_scan_find(const double*      elems, list_idx_t from, const list_idx_t to, const double      key);
+list_idx_t list_scan_find(const long double* elems, list_idx_t from, const list_idx_t to, const long double key);
+
+/**
+ * @brief Returns name of instruction set list_scan_find uses
+ *
+ * @return const char*
+ */
+const char* list_scan_isa();
+
+#endif //< #ifndef LIST_SCAN_H_
@@ -0,0 +1,267 @@
+#include "list_value_index.h"
+#include "list_order_index.h"
+
+/**
+ * @brief Returns first table entry of elem probe sequence
+ *
+ * @param index
+ * @param elem
+ * @return list_idx_t
+ */
+template <typename T>
+static list_idx_t list_value_index_start_(const ListValueIndex* index, const T elem) {
+    assert(index);
+
+    return (list_idx_t)(ListElemTraits<T>::hash(elem) & (uint64_t)(index->table_cap - 1));
+}
+
+/**
+ * @brief Returns table entry, that contains phys_i
+ *
+ * @param list
+ * @param elem element, phys_i was hashed by
+ * @param phys_i
+ * @return list_idx_t
+ */
+template <typename T>
+static list_idx_t list_value_index_locate_(const List<T>* list, const T elem, const list_idx_t phys_i) {
+    assert(list);
+
+    const ListValueIndex* index = list->value_index;
+    const list_idx_t mask = index->table_cap - 1;
+
+    list_idx_t entry = list_value_index_start_(index, elem);
+
+    while (index->table[entry] != phys_i) {
+        assert(index->table[entry] != index->EMPTY);
+
+        entry = (entry + 1) & mask;
+    }
+
+    return entry;
+}
+
+/**
+ * @brief Builds index from scratch in O(capacity)
+ *
+ * @param list
+ * @return true success
+ * @return false allocation error
+ */
+template <typename T>
+static bool list_value_index_rebuild_(const List<T>* list) {
+    assert(list);
+
+    ListValueIndex* index = list->value_index;
+    assert(index);
+
+    // load factor is kept below 1/2, so table is rebuilt after at least size/4 updates
+    list_idx_t table_cap = 16;
+    while (table_cap < 4 * list->size)
+        table_cap *= 2;
+
+    if (table_cap != index->table_cap) {
+        list_idx_t* table = (list_idx_t*)realloc(index->table, (size_t)table_cap * sizeof(list_idx_t));
+
+        if (table == nullptr) {
+            index->is_valid = false;
+            return false;
+        }
+
+        index->table     = table;
+        index->table_cap = table_cap;
+    }
+
+    for (list_idx_t i = 0; i < index->table_cap; i++)
+        index->table[i] = index->EMPTY;
+
+    index->used  = 0;
+    index->tombs = 0;
+
+    const list_idx_t mask = index->table_cap - 1;
+
+    // physical order is used, so data is read sequentially
+    for (list_idx_t phys_i = 1; phys_i < list->free_watermark; phys_i++) {
+        if (list_is_free(list, phys_i))
+            continue;
+
+        list_idx_t entry = list_value_index_start_(index, list_elem(list, phys_i));
+
+        while (index->table[entry] != index->EMPTY)
+            entry = (entry + 1) & mask;
+
+        index->table[entry] = phys_i;
+        index->used++;
+    }
+
+    index->is_valid = true;
+    return true;
+}
+
+template <typename T>
+int list_value_index_enable(List<T>* list) {
+    assert(list);
+
+    if (list->value_index != nullptr)
+        return list->OK;
+
+    list->value_index = (ListValueIndex*)calloc(1, sizeof(ListValueIndex));
+
+    if (list->value_index == nullptr)
+        return list->ALLOC_ERR;
+
+    return list->OK;
+}
+
+template <typename T>
+void list_value_index_disable(List<T>* list) {
+    assert(list);
+
+    if (list->value_index == nullptr)
+        return;
+
+    free(list->value_index->table);
+
+    FREE(list->value_index);
+}
+
+template <typename T>
+bool list_value_index_find(const List<T>* list, const T elem, list_idx_t* physical_i) {
+    assert(list);
+    assert(list->value_index);
+    assert(physical_i);
+
+    ListValueIndex* index = list->value_index;
+
+    if (!index->is_valid && !list_value_index_rebuild_(list))
+        return false;
+
+    const list_idx_t mask  = index->table_cap - 1;
+    const list_idx_t start = list_value_index_start_(index, elem);
+
+    list_idx_t first_linear = -1;   //< min candidate from linear prefix
+    list_idx_t other        = -1;   //< any candidate out of linear prefix
+    list_idx_t others_num   = 0;
+
+    for (list_idx_t entry = start; index->table[entry] != index->EMPTY; entry = (entry + 1) & mask) {
+        const list_idx_t phys_i = index->table[entry];
+
+        if (phys_i == index->TOMBSTONE || !ListElemTraits<T>::equal(list_elem(list, phys_i), elem))
+            continue;
+
+        if (list_linear_log(list, phys_i) < list->linear_prefix) {
+            if (first_linear == -1 || list_linear_log(list, phys_i) < list_linear_log(list, first_linear))
+                first_linear = phys_i;
+        } else {
+            other = phys_i;
+            others_num++;
+        }
+    }
+
+    // linear prefix goes before other elements
+    if (first_linear != -1 || others_num <= 1) {
+        *physical_i = first_linear != -1 ? first_linear : other;
+        return true;
+    }
+
+    if (list->order_index == nullptr)
+        return false;
+
+    list_idx_t first_log = -1;
+
+    for (list_idx_t entry = start; index->table[entry] != index->EMPTY; entry = (entry + 1) & mask) {
+        const list_idx_t phys_i = index->table[entry];
+
+        if (phys_i == index->TOMBSTONE || !ListElemTraits<T>::equal(list_elem(list, phys_i), elem))
+            continue;
+
+        list_idx_t log_i = -1;
+        if (!list_order_index_logical(list, phys_i, &log_i))
+            return false;
+
+        if (first_log == -1 || log_i < first_log) {
+            first_log   = log_i;
+            *physical_i = phys_i;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+void list_value_index_insert(List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+    assert(!list_is_free(list, phys_i));
+
+    ListValueIndex* index = list->value_index;
+
+    if (index == nullptr || !index->is_valid)
+        return;
+
+    if ((index->used + index->tombs + 1) * 2 > index->table_cap) {
+        // element is already in list, so rebuild adds it
+        list_value_index_rebuild_(list);
+        return;
+    }
+
+    const list_idx_t mask = index->table_cap - 1;
+
+    list_idx_t entry = list_value_index_start_(index, list_elem(list, phys_i));
+
+    while (index->table[entry] != index->EMPTY && index->table[entry] != index->TOMBSTONE)
+        entry = (entry + 1) & mask;
+
+    if (index->table[entry] == index->TOMBSTONE)
+        index->tombs--;
+
+    index->table[entry] = phys_i;
+    index->used++;
+}
+
+template <typename T>
+void list_value_index_delete(List<T>* list, const list_idx_t phys_i) {
+    assert(list);
+    assert(!list_is_free(list, phys_i));
+
+    ListValueIndex* index = list->value_index;
+
+    if (index == nullptr || !index->is_valid)
+        return;
+
+    index->table[list_value_index_locate_(list, list_elem(list, phys_i), phys_i)] = index->TOMBSTONE;
+
+    index->used--;
+    index->tombs++;
+}
+
+template <typename T>
+void list_value_index_swap(List<T>* list, const list_idx_t a, const list_idx_t b) {
+    assert(list);
+
+    ListValueIndex* index = list->value_index;
+
+    if (index == nullptr || !index->is_valid)
+        return;
+
+    // both entries are located before update, because element a is hashed to find entry of a
+    const list_idx_t entry_a = list_is_free(list, b) ? -1 : list_value_index_locate_(list, list_elem(list, b), a);
+    const list_idx_t entry_b = list_is_free(list, a) ? -1 : list_value_index_locate_(list, list_elem(list, a), b);
+
+    if (entry_a != -1)
+        index->table[entry_a] = b;
+
+    if (entry_b != -1)
+        index->table[entry_b] = a;
+}
+
+#define LIST_VALUE_INDEX_INSTANTIATE_(T)                                                            \
+    template int  list_value_index_enable(List<T>* list);                                           \
+    template void list_value_index_disable(List<T>* list);                                          \
+    template bool list_value_index_find(const List<T>* list, const T elem, list_idx_t* physical_i); \
+    template void list_value_index_insert(List<T>* list, const list_idx_t phys_i);                  \
+    template void list_value_index_delete(List<T>* list, const list_idx_t phys_i);                  \
+    template void list_value_index_swap(List<T>* list, const list_idx_t a, const list_idx_t b);
+
+LIST_ELEM_TYPES(LIST_VALUE_INDEX_INSTANTIATE_)
+
+#undef LIST_VALUE_INDEX_INSTANTIATE_
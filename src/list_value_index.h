@@ -0,0 +1,95 @@
+#ifndef LIST_VALUE_INDEX_H_
+#define LIST_VALUE_INDEX_H_
+
+#include "list.h"
+
+/**
+ * @brief Value index. Open addressing (linear probing) hash table of physical indexes,
+ *        hashed by their elements. Equal elements have one entry per element
+ *
+ * @attention It is rebuilt lazily (O(capacity)) on the first lookup after linearisation
+ */
+struct ListValueIndex {
+    list_idx_t* table = nullptr;        //< physical indexes. EMPTY or TOMBSTONE for unused entries
+
+    list_idx_t table_cap = 0;           //< table length (power of 2)
+    list_idx_t used      = 0;           //< number of physical indexes in table
+    list_idx_t tombs     = 0;           //< number of TOMBSTONE entries
+
+    bool is_valid = false;              //< false if index has to be rebuilt
+
+    static const list_idx_t EMPTY     =  0;  //< never used entry (physical index 0 is never stored)
+    static const list_idx_t TOMBSTONE = -1;  //< entry of deleted element
+};
+
+/**
+ * @brief Creates value index for list. Insert and delete update it incrementally
+ *
+ * @param list
+ * @return int
+ */
+template <typename T>
+int list_value_index_enable(List<T>* list);
+
+/**
+ * @brief Destroys list value index
+ *
+ * @param list
+ */
+template <typename T>
+void list_value_index_disable(List<T>* list);
+
+/**
+ * @brief Marks index to be rebuilt on next lookup
+ *
+ * @param list
+ */
+template <typename T>
+inline void list_value_index_invalidate(const List<T>* list) {
+    if (list->value_index != nullptr)
+        list->value_index->is_valid = false;
+}
+
+/**
+ * @brief Finds first (in logical order) element equal to elem in O(1) expected
+ *
+ * @attention Duplicates are ordered by linear prefix or by order index (if it is enabled)
+ *
+ * @param list
+ * @param elem
+ * @param physical_i returnable value. -1 if not found
+ * @return true success
+ * @return false index can't be built or duplicates can't be ordered
+ */
+template <typename T>
+bool list_value_index_find(const List<T>* list, const T elem, list_idx_t* physical_i);
+
+/**
+ * @brief Adds element phys_i to index
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+void list_value_index_insert(List<T>* list, const list_idx_t phys_i);
+
+/**
+ * @brief Removes element phys_i from index. Must be called before element is poisoned
+ *
+ * @param list
+ * @param phys_i
+ */
+template <typename T>
+void list_value_index_delete(List<T>* list, const list_idx_t phys_i);
+
+/**
+ * @brief Updates index after contents of slots a and b were swapped
+ *
+ * @param list
+ * @param a
+ * @param b
+ */
+template <typename T>
+void list_value_index_swap(List<T>* list, const list_idx_t a, const list_idx_t b);
+
+#endif //< #ifndef LIST_VALUE_INDEX_H_
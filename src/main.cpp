@@ -5,10 +5,10 @@ ListLogFileData list_log_file = {"log"};
 
 int main() {
 
-    List list = {};
+    List<int> list = {};
     LIST_CTOR(&list);
 
-    size_t index = 0;
+    list_idx_t index = 0;
     LIST_DUMP(&list);
 
     list_insert_after(&list, 0, 0,  &index);
@@ -28,8 +28,8 @@ int main() {
     list_insert_after(&list, 2, 50, &index);
     list_insert_after(&list, 2, 60, &index);
     list_insert_after(&list, 2, 70, &index);
-    list_insert_after(&list, 8, 80, &index);
-    list_insert_after(&list, 9, 90, &index);
+    list_insert_after(&list, index, 80, &index);
+    list_insert_after(&list, index, 90, &index);
 
     LIST_DUMP(&list);
 
@@ -1,8 +1,87 @@
 #include "ptr_valid.h"
 
-#ifdef LINUX_MANUAL_PTR_VALIDATION
+#if defined(__linux__) || defined(LINUX_MANUAL_PTR_VALIDATION)
+
+/**
+ * @brief Cached ranges of /proc/self/maps (sorted by begin)
+ */
+struct PtrValidMaps {
+    uintptr_t* begins   = nullptr;
+    uintptr_t* ends     = nullptr;
+    bool*      writable = nullptr; //< 'w' flag of range permissions
+
+    size_t size     = 0;
+    size_t capacity = 0;
+};
+
+static PtrValidMaps ptr_valid_maps = {};
+
+/**
+ * @brief Adds range to cache
+ *
+ * @param maps
+ * @param begin
+ * @param end
+ * @param writable range has write permission
+ * @return true success
+ * @return false allocation error
+ */
+static bool ptr_valid_maps_push_(PtrValidMaps* maps, const uintptr_t begin, const uintptr_t end,
+                                 const bool writable) {
+    assert(maps);
+
+    if (maps->size == maps->capacity) {
+        const size_t new_capacity = maps->capacity == 0 ? 64 : maps->capacity * 2;
+
+        uintptr_t* begins = (uintptr_t*)realloc(maps->begins, new_capacity * sizeof(uintptr_t));
+        if (!begins)
+            return false;
+        maps->begins = begins;
+
+        uintptr_t* ends = (uintptr_t*)realloc(maps->ends, new_capacity * sizeof(uintptr_t));
+        if (!ends)
+            return false;
+        maps->ends = ends;
+
+        bool* writable_flags = (bool*)realloc(maps->writable, new_capacity * sizeof(bool));
+        if (!writable_flags)
+            return false;
+        maps->writable = writable_flags;
+
+        maps->capacity = new_capacity;
+    }
+
+    // neighbour ranges with same permission are merged, so lookup is shorter
+    if (maps->size > 0 && maps->ends[maps->size - 1] == begin && maps->writable[maps->size - 1] == writable) {
+        maps->ends[maps->size - 1] = end;
+        return true;
+    }
+
+    maps->begins  [maps->size] = begin;
+    maps->ends    [maps->size] = end;
+    maps->writable[maps->size] = writable;
+    maps->size++;
+
+    return true;
+}
+
+/**
+ * @brief Rereads /proc/self/maps to cache
+ *
+ * @param maps
+ * @return true success
+ * @return false error
+ */
+static bool ptr_valid_maps_reload_(PtrValidMaps* maps) {
+    assert(maps);
+
+    maps->size = 0;
+
+    FILE* file = fopen("/proc/self/maps", "r");
+
+    if (!file)
+        return false;
 
-bool is_ptr_valid(void* p) {
     uintptr_t begin = 0;
     uintptr_t end = 0;
 
@@ -11,18 +90,14 @@ bool is_ptr_valid(void* p) {
     char executable = '\0';
     char mapped     = '\0';
 
-    FILE* file = fopen("/proc/self/maps", "r");
-
-    if (!file)
-        return false;
+    bool is_ok = true;
 
     while (fscanf(file, "%" SCNxPTR "-%" SCNxPTR " %c%c%c%c",
             &begin, &end, &readable, &writable, &executable, &mapped) == 6) {
 
-        if (begin <= (uintptr_t)p && (uintptr_t)p < end) {
-            fclose(file);
-
-            return writable == 'w';
+        if (!ptr_valid_maps_push_(maps, begin, end, writable == 'w')) {
+            is_ok = false;
+            break;
         }
 
         int c = '\0';
@@ -33,10 +108,56 @@ bool is_ptr_valid(void* p) {
 
     fclose(file);
 
-    return false;
+    return is_ok;
+}
+
+/**
+ * @brief Binary search of address in cache
+ *
+ * @param maps
+ * @param address
+ * @return index of range containing address
+ * @return maps->size if address is not in any range
+ */
+static size_t ptr_valid_maps_find_(const PtrValidMaps* maps, const uintptr_t address) {
+    assert(maps);
+
+    size_t left = 0;
+    size_t right = maps->size;
+
+    while (left < right) {
+        const size_t mid = left + (right - left) / 2;
+
+        if (maps->ends[mid] <= address)
+            left = mid + 1;
+        else
+            right = mid;
+    }
 
+    return left < maps->size && maps->begins[left] <= address ? left : maps->size;
 }
-#else // #ifndef LINUX_MANUAL_PTR_VALIDATION
+
+bool is_ptr_valid(void* p) {
+    const uintptr_t address = (uintptr_t)p;
+
+    // null page is never mapped
+    if (address < 4096)
+        return false;
+
+    size_t range = ptr_valid_maps_find_(&ptr_valid_maps, address);
+
+    if (range < ptr_valid_maps.size && ptr_valid_maps.writable[range])
+        return true;
+
+    // mapping could be created or its permissions changed after last reload
+    if (!ptr_valid_maps_reload_(&ptr_valid_maps))
+        return false;
+
+    range = ptr_valid_maps_find_(&ptr_valid_maps, address);
+
+    return range < ptr_valid_maps.size && ptr_valid_maps.writable[range];
+}
+#else // #if !defined(__linux__) && !defined(LINUX_MANUAL_PTR_VALIDATION)
 
 #ifdef _WIN32
 
@@ -60,39 +181,36 @@ bool is_ptr_valid(void* p) {
 
 
 bool is_ptr_valid(void* p) {
-    char filename[] = "/tmp/kurwa_ptr.XXXXXX";
-    int file = mkstemp(filename);
+    // one pipe is reused, so there is no filesystem traffic. Written byte is read back
+    static int probe[2] = {-1, -1};
 
-    if (file == -1) {
+    if (probe[0] == -1 && pipe(probe) == -1) {
         perror("");
-        assert(0 && "Error opening tmp file");
+        assert(0 && "Error opening probe pipe");
         return false;
     }
 
-    bool ret = false;
-
-    ssize_t res = write(file, p, 1);
+    ssize_t res = write(probe[1], p, 1);
 
     if (res == 1) {
-        ret = true;
-    } else if (errno == EFAULT) {
-        ret = false;
-    } else {
-        assert(0 && "Error writing to tmp file");
-    }
+        char c = '\0';
+
+        if (read(probe[0], &c, 1) != 1)
+            assert(0 && "Error reading probe pipe");
 
-    if (close(file) == -1) {
-        assert(0 && "Error closing tmp file");
-        ret = false;
+        return true;
     }
 
-    return ret;
+    if (errno != EFAULT)
+        assert(0 && "Error writing to probe pipe");
+
+    return false;
 }
 
 #endif // #ifdef unix || __APPLE__
 
 #endif // #ifdef _WIN32
 
-#endif // #ifdef LINUX_MANUAL_PTR_VALIDATION
+#endif // #if defined(__linux__) || defined(LINUX_MANUAL_PTR_VALIDATION)
 
 
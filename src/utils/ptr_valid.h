@@ -4,12 +4,13 @@
 #include <assert.h>
 #include <stdio.h>
 
-#ifdef LINUX_MANUAL_PTR_VALIDATION
+#if defined(__linux__) || defined(LINUX_MANUAL_PTR_VALIDATION)
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
-#else // #ifndef LINUX_MANUAL_PTR_VALIDATION
+#else // #ifndef __linux__
 
 #ifdef _WIN32
 
@@ -29,14 +30,18 @@
 
 #endif // #ifdef _WIN32
 
-#endif // #ifdef LINUX_MANUAL_PTR_VALIDATION
+#endif // #if defined(__linux__) || defined(LINUX_MANUAL_PTR_VALIDATION)
 
 
 /**
  * @brief Checks if pointer is valid for access in mode
  *
+ * @attention On Linux ranges of /proc/self/maps are cached and reread only if
+ *            pointer is not found in writable cached range. So valid pointer check takes nanoseconds,
+ *            but every invalid pointer outside null page costs full reread (tens of microseconds)
+ *
  * @param p pointer
- * @return true is valid
+ * @return true is valid (on Linux: mapped writable)
  * @return false is not valid
  */
 bool is_ptr_valid(void* p);
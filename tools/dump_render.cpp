@@ -0,0 +1,33 @@
+#include "../src/list_log/list_log.h"
+#include "../src/list.h"
+
+ListLogFileData list_log_file = {"log"};
+
+/**
+ * @brief Renders snapshots saved by list_dump_ring_save to log (log.html + dot images)
+ */
+int main(int argc, const char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <snapshots file>\n", argv[0]);
+        return 1;
+    }
+
+    if (!list_dump_ring_load(argv[1])) {
+        fprintf(stderr, "Error loading snapshots from \"%s\"\n", argv[1]);
+        return 1;
+    }
+
+    const size_t snapshots_num = list_dump_ring_size();
+
+    const bool res = list_dump_ring_render();
+
+    list_dump_ring_stop();
+
+    if (!res) {
+        fprintf(stderr, "Some snapshots are damaged\n");
+        return 1;
+    }
+
+    printf("%zu snapshots rendered\n", snapshots_num);
+    return 0;
+}